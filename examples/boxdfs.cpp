@@ -0,0 +1,74 @@
+#include <gecode/float/float.hh>
+#include <gecode/float/branch.hh>
+#include <gecode/float/arith.hh>
+#include <gecode/float/search.hh>
+#include <gecode/search.hh>
+
+using namespace Gecode;
+
+/*
+ * BoxDFS must find the same solutions as DFS: both explore the same
+ * tree, BoxDFS only stores boxes instead of spaces.
+ */
+class Parabola : public Space {
+private:
+  FloatVarArray f;
+public:
+  Parabola() : f(this, 2, -2.0, 2.0) {
+    FloatVar x(f[0]), y(f[1]);
+    hc4(this, x*x + y*y = 1.0);
+    hc4(this, y = x*x);
+    FloatVarArgs v(2);
+    v[0] = x; v[1] = y;
+    branch(this, v, FLOAT_VAR_SIZE_MAX, FLOAT_VAL_SPLIT_MIN);
+  }
+
+  Parabola(bool share, Parabola& p) : Space(share, p) {
+    f.update(this, share, p.f);
+  }
+
+  Parabola* copy(bool share) {
+    return new Parabola(share, *this);
+  }
+
+  FloatVarArray& floats(void) {
+    return f;
+  }
+};
+
+int main() {
+  Parabola* p = new Parabola;
+  DFS<Parabola> d(p);
+  BoxDFS<Parabola> b(p);
+  delete p;
+
+  int errors = 0;
+  unsigned long int n = 0;
+  while (true) {
+    Parabola* s = d.next();
+    Parabola* t = b.next();
+    if ((s == NULL) || (t == NULL)) {
+      if (s != t) {
+        std::cerr << "boxdfs: numbers of solutions differ" << std::endl;
+        errors++;
+      }
+      delete s; delete t;
+      break;
+    }
+    for (int i = s->floats().size(); i--; )
+      if ((s->floats()[i].min() != t->floats()[i].min()) ||
+          (s->floats()[i].max() != t->floats()[i].max())) {
+        std::cerr << "boxdfs: solution " << n << " differs" << std::endl;
+        errors++;
+        break;
+      }
+    n++;
+    delete s; delete t;
+  }
+  std::cout << "boxdfs: " << n << " solutions" << std::endl;
+  if (n == 0) {
+    std::cerr << "boxdfs: no solution found" << std::endl;
+    errors++;
+  }
+  return (errors == 0) ? 0 : 1;
+}
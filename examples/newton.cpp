@@ -0,0 +1,86 @@
+#include <gecode/float/float.hh>
+#include <gecode/float/arith.hh>
+#include <gecode/float/global.hh>
+
+#include <cmath>
+
+using namespace Gecode;
+
+/*
+ * Newton uniqueness: the circle x^2+y^2=1 meets the line x=y in
+ * [0.5,1]^2 only at (1/sqrt(2),1/sqrt(2)). The Newton propagator must
+ * keep that root and prove it unique.
+ */
+class Circle : public Space {
+private:
+  FloatVarArray f;
+  BoolVar u;
+public:
+  Circle(double lb, double ub) : f(this, 2, lb, ub), u(this, 0, 1) {
+    FloatVar x(f[0]), y(f[1]);
+    EquationArgs e(2);
+    e[0] = (x*x + y*y = 1.0);
+    e[1] = (x - y = 0.0);
+    FloatVarArgs v(2);
+    v[0] = x; v[1] = y;
+    hc4(this, e[0]);
+    hc4(this, e[1]);
+    newton(this, e, v, u);
+  }
+
+  Circle(bool share, Circle& c) : Space(share, c) {
+    f.update(this, share, c.f);
+    u.update(this, share, c.u);
+  }
+
+  Circle* copy(bool share) {
+    return new Circle(share, *this);
+  }
+
+  bool unique(void) const {
+    return u.min() == 1;
+  }
+
+  bool contains(double r) const {
+    for (int i = 0; i < f.size(); i++)
+      if ((f[i].min() > r) || (f[i].max() < r))
+        return false;
+    return true;
+  }
+
+  void print() {
+    std::cout << f << " unique=" << unique() << std::endl;
+  }
+};
+
+int main() {
+  const double r = std::sqrt(0.5);
+  int errors = 0;
+
+  Circle* c = new Circle(0.5, 1.0);
+  if (c->status() == SS_FAILED) {
+    std::cerr << "newton: the root was removed" << std::endl;
+    errors++;
+  } else {
+    c->print();
+    if (!c->contains(r)) {
+      std::cerr << "newton: the root is not enclosed" << std::endl;
+      errors++;
+    }
+    if (!c->unique()) {
+      std::cerr << "newton: uniqueness was not proven" << std::endl;
+      errors++;
+    }
+  }
+  delete c;
+
+  // Two roots in [-1,1]^2, so uniqueness must not be claimed
+  c = new Circle(-1.0, 1.0);
+  if ((c->status() != SS_FAILED) && c->unique()) {
+    std::cerr << "newton: uniqueness claimed for two roots" << std::endl;
+    errors++;
+  }
+  delete c;
+
+  return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+#include <gecode/float/float.hh>
+#include <gecode/float/branch.hh>
+#include <gecode/float/arith.hh>
+#include <gecode/float/search.hh>
+
+#include <cmath>
+
+using namespace Gecode;
+
+/*
+ * Minimize x+y on the unit circle. The optimum is -sqrt(2) at
+ * (-1/sqrt(2),-1/sqrt(2)). The probe certifies points on the circle,
+ * so branch-and-bound must enclose the optimum between lower() and
+ * upper() with an incumbent.
+ */
+class Circle : public Space {
+private:
+  FloatVarArray f;
+public:
+  Circle() : f(this, 3, -2.0, 2.0) {
+    FloatVar x(f[0]), y(f[1]), z(f[2]);
+    hc4(this, x*x + y*y = 1.0);
+    hc4(this, z = x + y);
+    FloatVarArgs v(2);
+    v[0] = x; v[1] = y;
+    branch(this, v, FLOAT_VAR_SIZE_MAX, FLOAT_VAL_SPLIT_MIN);
+  }
+
+  Circle(bool share, Circle& c) : Space(share, c) {
+    f.update(this, share, c.f);
+  }
+
+  Circle* copy(bool share) {
+    return new Circle(share, *this);
+  }
+
+  FloatVarArray& floats(void) {
+    return f;
+  }
+
+  FloatVar objective(void) {
+    return f[2];
+  }
+};
+
+int main() {
+  const double opt = -std::sqrt(2.0);
+  int errors = 0;
+
+  Circle* c = new Circle;
+  FloatVar x(c->floats()[0]), y(c->floats()[1]), z(c->floats()[2]);
+  // The inner test holds all posted constraints
+  Float::Search::Inner in(c->floats());
+  in.add(x*x + y*y = 1.0);
+  in.add(z = x + y);
+  Float::Search::Probe p(c->floats(), z, in);
+
+  BoxBAB<Circle> e(c, true, 1e-4, 1e-4, &in, &p);
+  delete c;
+  while (Circle* s = e.next())
+    delete s;
+
+  std::cout << "optimize: optimum in [" << e.lower() << ","
+            << e.upper() << "], " << e.statistics().probe
+            << " probed incumbents" << std::endl;
+  if (!(e.upper() < std::numeric_limits<double>::infinity())) {
+    std::cerr << "optimize: no incumbent was certified" << std::endl;
+    errors++;
+  }
+  if ((e.lower() > opt) || (e.upper() < opt)) {
+    std::cerr << "optimize: the optimum is not enclosed" << std::endl;
+    errors++;
+  }
+  if (e.upper() - e.lower() > 0.05) {
+    std::cerr << "optimize: the gap is too wide" << std::endl;
+    errors++;
+  }
+  return (errors == 0) ? 0 : 1;
+}
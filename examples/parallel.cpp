@@ -0,0 +1,77 @@
+#include <gecode/float/float.hh>
+#include <gecode/float/branch.hh>
+#include <gecode/float/arith.hh>
+#include <gecode/float/search.hh>
+
+using namespace Gecode;
+
+/*
+ * ParallelDFS with deterministic ordering must return the solutions of
+ * BoxDFS in the same order, for any number of threads.
+ */
+class Parabola : public Space {
+private:
+  FloatVarArray f;
+public:
+  Parabola() : f(this, 2, -2.0, 2.0) {
+    FloatVar x(f[0]), y(f[1]);
+    hc4(this, x*x + y*y = 1.0);
+    hc4(this, y = x*x);
+    FloatVarArgs v(2);
+    v[0] = x; v[1] = y;
+    branch(this, v, FLOAT_VAR_SIZE_MAX, FLOAT_VAL_SPLIT_MIN);
+  }
+
+  Parabola(bool share, Parabola& p) : Space(share, p) {
+    f.update(this, share, p.f);
+  }
+
+  Parabola* copy(bool share) {
+    return new Parabola(share, *this);
+  }
+
+  FloatVarArray& floats(void) {
+    return f;
+  }
+};
+
+int check(unsigned int threads) {
+  Parabola* p = new Parabola;
+  BoxDFS<Parabola> b(p);
+  ParallelDFS<Parabola> d(p, threads, true);
+  delete p;
+
+  int errors = 0;
+  unsigned long int n = 0;
+  while (true) {
+    Parabola* s = b.next();
+    Parabola* t = d.next();
+    if ((s == NULL) || (t == NULL)) {
+      if (s != t) {
+        std::cerr << "parallel: numbers of solutions differ with "
+                  << threads << " threads" << std::endl;
+        errors++;
+      }
+      delete s; delete t;
+      break;
+    }
+    for (int i = s->floats().size(); i--; )
+      if ((s->floats()[i].min() != t->floats()[i].min()) ||
+          (s->floats()[i].max() != t->floats()[i].max())) {
+        std::cerr << "parallel: solution " << n << " differs with "
+                  << threads << " threads" << std::endl;
+        errors++;
+        break;
+      }
+    n++;
+    delete s; delete t;
+  }
+  std::cout << "parallel: " << n << " solutions with " << threads
+            << " threads" << std::endl;
+  return errors;
+}
+
+int main() {
+  int errors = check(1) + check(2) + check(4);
+  return (errors == 0) ? 0 : 1;
+}
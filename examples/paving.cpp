@@ -0,0 +1,91 @@
+#include <gecode/float/float.hh>
+#include <gecode/float/branch.hh>
+#include <gecode/float/arith.hh>
+#include <gecode/float/search.hh>
+
+#include <cmath>
+
+using namespace Gecode;
+
+/*
+ * Paving of the unit disk x^2+y^2<=1, written with the slack r in
+ * [0,1]. The inner boxes lie in the disk and the boundary boxes cover
+ * the rest of it, so the inner volume is at most pi and both volumes
+ * together at least pi. Merging must keep the volumes and not add
+ * boxes.
+ */
+class Disk : public Space {
+private:
+  FloatVarArray f;
+  FloatVar r;
+public:
+  Disk() : f(this, 2, -2.0, 2.0), r(this, 0.0, 1.0) {
+    FloatVar x(f[0]), y(f[1]);
+    hc4(this, x*x + y*y = r);
+    FloatVarArgs v(2);
+    v[0] = x; v[1] = y;
+    branch(this, v, FLOAT_VAR_SIZE_MAX, FLOAT_VAL_SPLIT_MIN);
+  }
+
+  Disk(bool share, Disk& d) : Space(share, d) {
+    f.update(this, share, d.f);
+    r.update(this, share, d.r);
+  }
+
+  Disk* copy(bool share) {
+    return new Disk(share, *this);
+  }
+
+  FloatVarArray& floats(void) {
+    return f;
+  }
+};
+
+int main() {
+  const double pi = 4.0 * std::atan(1.0);
+  int errors = 0;
+
+  Disk* d = new Disk;
+  // The slack is eliminated: the disk itself is the constraint
+  FloatVar x(d->floats()[0]), y(d->floats()[1]);
+  Float::Search::Inner in(d->floats());
+  in.add(x*x + y*y = 1.0, FRT_LQ);
+
+  Float::Search::Paving p(2, false), m(2, true);
+  pave(d, p, &in);
+  pave(d, m, &in);
+  delete d;
+
+  for (int k = 0; k < 2; k++) {
+    const Float::Search::Paving& q = (k == 0) ? p : m;
+    double vi = q.volume(Float::Search::BT_INNER);
+    double vb = q.volume(Float::Search::BT_BOUNDARY);
+    std::cout << (q.merging() ? "merged" : "plain") << ": "
+              << q.size(Float::Search::BT_INNER) << " inner and "
+              << q.size(Float::Search::BT_BOUNDARY) << " boundary boxes, "
+              << "volumes " << vi << " and " << vb << std::endl;
+    if ((vi > pi) || (vi + vb < pi)) {
+      std::cerr << "paving: the volumes do not enclose pi" << std::endl;
+      errors++;
+    }
+  }
+
+  for (int t = 0; t < 2; t++) {
+    Float::Search::BoxType bt = static_cast<Float::Search::BoxType>(t);
+    if (m.size(bt) > p.size(bt)) {
+      std::cerr << "paving: merging added boxes" << std::endl;
+      errors++;
+    }
+    if (std::abs(m.volume(bt) - p.volume(bt)) > 1e-9 * p.volume(bt)) {
+      std::cerr << "paving: merging changed the volume" << std::endl;
+      errors++;
+    }
+  }
+  if ((p.size(Float::Search::BT_INNER) > 1) &&
+      (m.size(Float::Search::BT_INNER) == p.size(Float::Search::BT_INNER))) {
+    std::cerr << "paving: no inner boxes were merged" << std::endl;
+    errors++;
+  }
+
+  return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+#include <gecode/float/float.hh>
+#include <gecode/float/branch.hh>
+#include <gecode/float/arith.hh>
+#include <gecode/float/global.hh>
+#include <gecode/float/search.hh>
+
+using namespace Gecode;
+
+/*
+ * Soundness of shaving and Bernstein contraction: the roots 1, 2 and 3
+ * of x^3-6x^2+11x-6 in [0,4] must each lie in a solution box, and every
+ * solution box must be close to a root.
+ */
+class Cubic : public Space {
+private:
+  FloatVarArray f;
+public:
+  enum Mode { HC4, SHAVE, BERNSTEIN };
+
+  Cubic(Mode m) : f(this, 1, 0.0, 4.0) {
+    FloatVar x(f[0]);
+    EquationArgs e(1);
+    e[0] = (x*x*x - x*x*6.0 + x*11.0 = 6.0);
+    hc4(this, e[0]);
+    switch (m) {
+    case SHAVE:
+      {
+        FloatVarArgs v(1);
+        v[0] = x;
+        shave(this, e, v);
+      }
+      break;
+    case BERNSTEIN:
+      bernstein(this, e[0]);
+      break;
+    default:
+      break;
+    }
+    FloatVarArgs v(1);
+    v[0] = x;
+    branch(this, v, FLOAT_VAR_NONE, FLOAT_VAL_SPLIT_MIN);
+  }
+
+  Cubic(bool share, Cubic& c) : Space(share, c) {
+    f.update(this, share, c.f);
+  }
+
+  Cubic* copy(bool share) {
+    return new Cubic(share, *this);
+  }
+
+  FloatVarArray& floats(void) {
+    return f;
+  }
+};
+
+int check(const char* name, Cubic::Mode m) {
+  const double roots[3] = { 1.0, 2.0, 3.0 };
+  bool found[3] = { false, false, false };
+  int errors = 0, n = 0;
+  Cubic* c = new Cubic(m);
+  BoxDFS<Cubic> e(c);
+  delete c;
+  while (Cubic* s = e.next()) {
+    double l = s->floats()[0].min(), u = s->floats()[0].max();
+    bool near = false;
+    for (int i = 3; i--; ) {
+      if ((l <= roots[i]) && (roots[i] <= u))
+        found[i] = true;
+      if ((l <= roots[i] + 0.1) && (roots[i] - 0.1 <= u))
+        near = true;
+    }
+    if (!near) {
+      std::cerr << name << ": box [" << l << "," << u
+                << "] is far from all roots" << std::endl;
+      errors++;
+    }
+    n++;
+    delete s;
+  }
+  for (int i = 3; i--; )
+    if (!found[i]) {
+      std::cerr << name << ": root " << roots[i] << " was lost" << std::endl;
+      errors++;
+    }
+  std::cout << name << ": " << n << " solution boxes" << std::endl;
+  return errors;
+}
+
+int main() {
+  int errors = check("hc4", Cubic::HC4) +
+    check("shave", Cubic::SHAVE) +
+    check("bernstein", Cubic::BERNSTEIN);
+  return (errors == 0) ? 0 : 1;
+}
@@ -37,6 +37,7 @@
  */
 
 #include <gecode/float/float.hh>
+#include <gecode/int.hh>
 
 namespace Gecode {
   namespace Float {
@@ -127,17 +128,102 @@ namespace Gecode {
      template <class View>
      class Tree : public Propagator {
      protected:
-       Equation eq;
+       typedef boost::numeric::interval<double> Interval;
+       /// The variables of the equation
+       ViewArray<View> x;
+       /// The equation, bound to the positions of \a x
+       SharedArray<Equation> eq;
      public:
-       Tree(Space* home, Equation& eq);
+       Tree(Space* home, ViewArray<View>& x, SharedArray<Equation>& eq);
        Tree(Space* home, bool share, Tree& p);
        virtual Actor* copy(Space* home, bool share);
        virtual ExecStatus propagate(Space* home, ModEventDelta med);
        virtual PropCost cost(ModEventDelta med) const;
+       virtual size_t dispose(Space* home);
        static  ExecStatus post(Space* home, Equation eq);
      };
 
+    /*
+     * Reified relation
+     *
+     */
+
+    /**
+     * \brief Reified relation \f$(x_0\sim_r x_1)\Leftrightarrow b\f$
+     *
+     * Decides \f$b\f$ from the bounds as soon as the relation is entailed
+     * or disentailed, and propagates the relation or its complement once
+     * \f$b\f$ is assigned.
+     */
+    template <class View>
+    class ReRel :
+      public MixTernaryPropagator<View,PC_FLOAT_BND,View,PC_FLOAT_BND,
+                                  Int::BoolView,Int::PC_BOOL_VAL> {
+    protected:
+      using MixTernaryPropagator<View,PC_FLOAT_BND,View,PC_FLOAT_BND,
+                                 Int::BoolView,Int::PC_BOOL_VAL>::x0;
+      using MixTernaryPropagator<View,PC_FLOAT_BND,View,PC_FLOAT_BND,
+                                 Int::BoolView,Int::PC_BOOL_VAL>::x1;
+      using MixTernaryPropagator<View,PC_FLOAT_BND,View,PC_FLOAT_BND,
+                                 Int::BoolView,Int::PC_BOOL_VAL>::x2;
+      /// The relation
+      FloatRelType r;
+      /// Constructor for cloning \a p
+      ReRel(Space* home, bool share, ReRel& p);
+      /// Constructor for posting
+      ReRel(Space* home, View x0, FloatRelType r, View x1, Int::BoolView b);
+    public:
+      /// Copy propagator during cloning
+      virtual Actor* copy(Space* home, bool share);
+      /// Perform propagation
+      virtual ExecStatus propagate(Space* home, ModEventDelta med);
+      /// Post propagator for \f$(x_0\sim_r x_1)\Leftrightarrow b\f$
+      static  ExecStatus post(Space* home, View x0, FloatRelType r, View x1,
+                              Int::BoolView b);
+    };
+
+    /*
+     * Reified HC4
+     *
+     */
+
+    /**
+     * \brief Reified equation \f$(e)\Leftrightarrow b\f$ propagated by HC4
+     *
+     * Entailment is checked by one evaluation of the residual of \a e:
+     * \f$b\f$ is zero if the residual excludes zero and one if it is
+     * zero. Once \f$b\f$ is one the equation is propagated like Tree.
+     */
+    template <class View>
+    class ReTree : public Propagator {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
+      /// The variables of the equation
+      ViewArray<View> x;
+      /// The equation, bound to the positions of \a x
+      SharedArray<Equation> eq;
+      /// The control variable
+      Int::BoolView b;
+      /// Constructor for cloning \a p
+      ReTree(Space* home, bool share, ReTree& p);
+      /// Constructor for posting
+      ReTree(Space* home, ViewArray<View>& x, SharedArray<Equation>& eq,
+             Int::BoolView b);
+    public:
+      /// Copy propagator during cloning
+      virtual Actor* copy(Space* home, bool share);
+      /// Perform propagation
+      virtual ExecStatus propagate(Space* home, ModEventDelta med);
+      /// Cost function
+      virtual PropCost cost(ModEventDelta med) const;
+      /// Delete propagator and return its size
+      virtual size_t dispose(Space* home);
+      /// Post propagator for \f$(e)\Leftrightarrow b\f$
+      static  ExecStatus post(Space* home, Equation e, Int::BoolView b);
+    };
+
    }
 }
 
 #include <gecode/float/arith/arith.hpp>
+#include <gecode/float/arith/reified.hpp>
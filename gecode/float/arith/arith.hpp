@@ -209,15 +209,21 @@ namespace Gecode {
      *
      */
 
+    /// The forward-backward pass is repeated while it keeps less than this ratio of the width
+    const double hc4_ratio = 0.99;
+
     template <class View>
-    Tree<View>::Tree(Space* home, Equation& eq)
-      : Propagator(home), eq(eq) {
-      eq.subscribe(home,this,PC_FLOAT_BND);
+    Tree<View>::Tree(Space* home, ViewArray<View>& x0, SharedArray<Equation>& eq0)
+      : Propagator(home), x(x0), eq(eq0) {
+      x.subscribe(home,this,PC_FLOAT_BND);
+      home->notice(this,AP_DISPOSE);
     }
 
     template <class View>
     Tree<View>::Tree(Space* home, bool share, Tree& p)
-      : Propagator(home,share,p), eq(p.eq) {
+      : Propagator(home,share,p) {
+      x.update(home,share,p.x);
+      eq.update(home,share,p.eq);
     }
 
     template <class View>
@@ -227,11 +233,25 @@ namespace Gecode {
 
     template <class View>
     ExecStatus Tree<View>::propagate(Space* home, ModEventDelta med) {
-      std::cout<<"pruning..."<<std::endl;
-
-      eq.evaluation();
-      eq.propagation();
-      return ES_NOFIX;
+      Box b(x.size());
+      double w = 0.0;
+      for (int i = x.size(); i--; ) {
+        b[i] = Interval(x[i].min(),x[i].max());
+        w += width(b[i]);
+      }
+      if (!eq[0].revise(b))
+        return ES_FAILED;
+
+      double v = 0.0;
+      for (int i = x.size(); i--; ) {
+        GECODE_ME_CHECK(x[i].gq(home,lower(b[i])));
+        GECODE_ME_CHECK(x[i].lq(home,upper(b[i])));
+        v += width(b[i]);
+      }
+      for (int i = x.size(); i--; )
+        if (!x[i].assigned())
+          return (v < hc4_ratio * w) ? ES_NOFIX : ES_FIX;
+      return ES_SUBSUMED(this,home);
     }
 
     template <class View>
@@ -240,8 +260,24 @@ namespace Gecode {
     }
 
     template <class View>
-    ExecStatus Tree<View>::post(Space* home, Equation eq) {
-      new (home) Tree(home,eq);
+    size_t Tree<View>::dispose(Space* home) {
+      home->ignore(this,AP_DISPOSE);
+      x.cancel(home,this,PC_FLOAT_BND);
+      eq.~SharedArray();
+      (void) Propagator::dispose(home);
+      return sizeof(*this);
+    }
+
+    template <class View>
+    ExecStatus Tree<View>::post(Space* home, Equation e) {
+      VarIndex vi;
+      SharedArray<Equation> eq(1);
+      eq[0] = e.rewrite();
+      eq[0].bind(vi);
+      ViewArray<View> x(home,vi.size());
+      for (int i = vi.size(); i--; )
+        x[i] = View(vi[i]);
+      new (home) Tree(home,x,eq);
       return ES_OK;
     }
 
@@ -290,7 +326,7 @@ namespace Gecode {
 
   void hc4(Space* home, Float::Equation eq) {
     if (home->failed()) return;
-    if (Float::Tree<Float::ExpresionView>::post(home,eq) != ES_OK)
+    if (Float::Tree<Float::FloatView>::post(home,eq) != ES_OK)
       home->fail();
   }
 
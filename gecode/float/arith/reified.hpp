@@ -0,0 +1,254 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /*
+     * Reified relation
+     *
+     */
+
+    template <class View>
+    forceinline
+    ReRel<View>::ReRel(Space* home, View x0, FloatRelType r0, View x1,
+                       Int::BoolView b)
+      : MixTernaryPropagator<View,PC_FLOAT_BND,View,PC_FLOAT_BND,
+                             Int::BoolView,Int::PC_BOOL_VAL>(home,x0,x1,b),
+        r(r0) {}
+
+    template <class View>
+    forceinline
+    ReRel<View>::ReRel(Space* home, bool share, ReRel& p)
+      : MixTernaryPropagator<View,PC_FLOAT_BND,View,PC_FLOAT_BND,
+                             Int::BoolView,Int::PC_BOOL_VAL>(home,share,p),
+        r(p.r) {}
+
+    template <class View>
+    Actor*
+    ReRel<View>::copy(Space* home, bool share) {
+      return new (home) ReRel(home,share,*this);
+    }
+
+    /// Propagate \f$x\sim_r y\f$ on the bounds of \a x and \a y
+    template <class View>
+    forceinline ExecStatus
+    relate(Space* home, View x, FloatRelType r, View y) {
+      if (r != FRT_GQ) {
+        GECODE_ME_CHECK(x.lq(home,y.max()));
+        GECODE_ME_CHECK(y.gq(home,x.min()));
+      }
+      if (r != FRT_LQ) {
+        GECODE_ME_CHECK(x.gq(home,y.min()));
+        GECODE_ME_CHECK(y.lq(home,x.max()));
+      }
+      return ES_OK;
+    }
+
+    template <class View>
+    ExecStatus
+    ReRel<View>::propagate(Space* home, ModEventDelta) {
+      bool ent = false, dis = false;
+      switch (r) {
+      case FRT_EQ:
+        ent = (x0.min() == x0.max()) && (x1.min() == x1.max()) &&
+          (x0.min() == x1.min());
+        dis = (x0.max() < x1.min()) || (x1.max() < x0.min());
+        break;
+      case FRT_LQ:
+        ent = x0.max() <= x1.min();
+        dis = x0.min() > x1.max();
+        break;
+      case FRT_GQ:
+        ent = x0.min() >= x1.max();
+        dis = x0.max() < x1.min();
+        break;
+      }
+      if (ent) {
+        GECODE_ME_CHECK(x2.one(home));
+        return ES_SUBSUMED(this,home);
+      }
+      if (dis) {
+        GECODE_ME_CHECK(x2.zero(home));
+        return ES_SUBSUMED(this,home);
+      }
+      if (x2.one()) {
+        GECODE_ES_CHECK(relate(home,x0,r,x1));
+      } else if (x2.zero() && (r != FRT_EQ)) {
+        // Closed hull of the complement
+        GECODE_ES_CHECK(relate(home,x0,(r == FRT_LQ) ? FRT_GQ : FRT_LQ,x1));
+      }
+      return ES_FIX;
+    }
+
+    template <class View>
+    ExecStatus
+    ReRel<View>::post(Space* home, View x0, FloatRelType r, View x1,
+                      Int::BoolView b) {
+      (void) new (home) ReRel(home,x0,r,x1,b);
+      return ES_OK;
+    }
+
+    /*
+     * Reified HC4
+     *
+     */
+
+    template <class View>
+    forceinline
+    ReTree<View>::ReTree(Space* home, ViewArray<View>& x0,
+                         SharedArray<Equation>& eq0, Int::BoolView b0)
+      : Propagator(home), x(x0), eq(eq0), b(b0) {
+      x.subscribe(home,this,PC_FLOAT_BND);
+      b.subscribe(home,this,Int::PC_BOOL_VAL);
+      home->notice(this,AP_DISPOSE);
+    }
+
+    template <class View>
+    forceinline
+    ReTree<View>::ReTree(Space* home, bool share, ReTree& p)
+      : Propagator(home,share,p) {
+      x.update(home,share,p.x);
+      eq.update(home,share,p.eq);
+      b.update(home,share,p.b);
+    }
+
+    template <class View>
+    Actor*
+    ReTree<View>::copy(Space* home, bool share) {
+      return new (home) ReTree(home,share,*this);
+    }
+
+    template <class View>
+    PropCost
+    ReTree<View>::cost(ModEventDelta) const {
+      return PC_TERNARY_LO;
+    }
+
+    template <class View>
+    size_t
+    ReTree<View>::dispose(Space* home) {
+      home->ignore(this,AP_DISPOSE);
+      x.cancel(home,this,PC_FLOAT_BND);
+      b.cancel(home,this,Int::PC_BOOL_VAL);
+      eq.~SharedArray();
+      (void) Propagator::dispose(home);
+      return sizeof(*this);
+    }
+
+    template <class View>
+    ExecStatus
+    ReTree<View>::propagate(Space* home, ModEventDelta) {
+      Box d(x.size());
+      double w = 0.0;
+      for (int i = x.size(); i--; ) {
+        d[i] = Interval(x[i].min(),x[i].max());
+        w += width(d[i]);
+      }
+
+      // Entailment by one evaluation of the residual
+      Interval r = eq[0].residual(d);
+      if (!zero_in(r)) {
+        GECODE_ME_CHECK(b.zero(home));
+        return ES_SUBSUMED(this,home);
+      }
+      if ((lower(r) == 0.0) && (upper(r) == 0.0)) {
+        GECODE_ME_CHECK(b.one(home));
+        return ES_SUBSUMED(this,home);
+      }
+      if (!b.one())
+        return ES_FIX;
+
+      if (!eq[0].revise(d))
+        return ES_FAILED;
+      double v = 0.0;
+      for (int i = x.size(); i--; ) {
+        GECODE_ME_CHECK(x[i].gq(home,lower(d[i])));
+        GECODE_ME_CHECK(x[i].lq(home,upper(d[i])));
+        v += width(d[i]);
+      }
+      return (v < hc4_ratio * w) ? ES_NOFIX : ES_FIX;
+    }
+
+    template <class View>
+    ExecStatus
+    ReTree<View>::post(Space* home, Equation e, Int::BoolView b) {
+      VarIndex vi;
+      SharedArray<Equation> eq(1);
+      eq[0] = e.rewrite();
+      eq[0].bind(vi);
+      ViewArray<View> x(home,vi.size());
+      for (int i = vi.size(); i--; )
+        x[i] = View(vi[i]);
+      (void) new (home) ReTree(home,x,eq,b);
+      return ES_OK;
+    }
+
+  }
+
+  /*
+   * Constraints
+   *
+   */
+
+  /// Post \f$(x\sim_r y)\Leftrightarrow b\f$
+  forceinline void
+  rel(Space* home, FloatVar x, FloatRelType r, FloatVar y, BoolVar b) {
+    if (home->failed()) return;
+    if (Float::ReRel<Float::FloatView>::post(home,x,r,y,b) != ES_OK)
+      home->fail();
+  }
+
+  /// Post \f$(x\sim_r c)\Leftrightarrow b\f$
+  forceinline void
+  rel(Space* home, FloatVar x, FloatRelType r, double c, BoolVar b) {
+    if (home->failed()) return;
+    FloatVar y(home,c,c);
+    if (Float::ReRel<Float::FloatView>::post(home,x,r,y,b) != ES_OK)
+      home->fail();
+  }
+
+  /// Post \f$(e)\Leftrightarrow b\f$, propagated by HC4
+  forceinline void
+  hc4(Space* home, Float::Equation eq, BoolVar b) {
+    if (home->failed()) return;
+    if (Float::ReTree<Float::FloatView>::post(home,eq,b) != ES_OK)
+      home->fail();
+  }
+
+}
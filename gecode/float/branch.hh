@@ -41,6 +41,36 @@
 
 #include <gecode/float/float.hh>
 
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace Gecode {
+
+  /// Which variable to select for branching
+  enum FloatVarBranch {
+    FLOAT_VAR_NONE,          ///< First unassigned
+    FLOAT_VAR_SIZE_MIN,      ///< With smallest domain
+    FLOAT_VAR_SIZE_MAX,      ///< With largest domain
+    FLOAT_VAR_ROUND_ROBIN,   ///< Next unassigned after the last one branched
+    FLOAT_VAR_WIDTH_REL_MAX, ///< With largest width relative to magnitude
+    FLOAT_VAR_SMEAR_SUM,     ///< With largest sum of smears over the equations
+    FLOAT_VAR_SMEAR_MAX_REL  ///< With largest smear relative to its equation
+  };
+
+  /// Which values to select first for branching
+  enum FloatValBranch {
+    FLOAT_VAL_SPLIT_MIN,   ///< Lower half first
+    FLOAT_VAL_SPLIT_MAX,   ///< Upper half first
+    FLOAT_VAL_SPLIT_RATIO, ///< Split at a ratio of the width, lower part first
+    FLOAT_VAL_SPLIT_MAG,   ///< Split wide domains by magnitude, lower part first
+    FLOAT_VAL_SPLIT_K,     ///< Split into k parts, from lower to upper
+    FLOAT_VAL_SPLIT_LAST   ///< Split at the last solution found, lower part first
+  };
+
+}
+
 /**
  * \namespace Gecode::Float::Branch
  * \brief %Float branchings
@@ -49,22 +79,115 @@ namespace Gecode {
   namespace Float {
     namespace Branch {
 
-      /// %Branching description
+      /**
+       * \brief Return a point splitting \f$[l,u]\f$
+       *
+       * Returns the midpoint unless the domain is unbounded, or \a mag
+       * is true and the domain is wide: positive or negative domains
+       * spanning more than split_wide orders are split at the geometric
+       * mean, domains around zero at zero, and unbounded domains at a
+       * point whose magnitude grows geometrically. The point is kept
+       * inside the domain, also for huge finite bounds.
+       */
+      double split(double l, double u, bool mag);
+
+      /// Return point \a a of \a n equal parts of \f$[l,u]\f$, without overflow
+      double part(double l, double u, unsigned int a, unsigned int n);
+
+      /**
+       * \brief Compact record of a float branching choice
+       *
+       * With two alternatives the view is split at \a val, with more
+       * alternatives the domain from \a val to the upper bound is cut
+       * into parts of equal width. A plain value that can be copied
+       * bytewise, see FloatPath.
+       */
+      struct FloatChoice {
+        /// Position of the view
+        int pos;
+        /// Number of alternatives
+        unsigned int alt;
+        /// Split value, or lower bound for more than two alternatives
+        double val;
+        /// Whether the upper part is the first of two alternatives
+        bool upper;
+      };
+
+      /// Narrow the bounds \a l and \a u to alternative \a a of \a c
+      void bounds(const FloatChoice& c, unsigned int a, double& l, double& u);
+
+      /// Commit view \a x to alternative \a a of \a c
+      ExecStatus commit(Space* home, FloatView x, const FloatChoice& c,
+                        unsigned int a);
+
+      /**
+       * \brief Path of choices and alternatives archived in a byte buffer
+       *
+       * The buffer can be sent to another process of the same
+       * architecture and replayed on a space in the state of the root,
+       * see replay().
+       */
+      class FloatPath {
+      private:
+        /// The archived entries
+        std::vector<unsigned char> b;
+        /// Size of an entry
+        static const size_t entry = sizeof(FloatChoice) + sizeof(unsigned int);
+      public:
+        /// Create empty path
+        FloatPath(void);
+        /// Create path from the \a n bytes at \a d
+        FloatPath(const unsigned char* d, size_t n);
+        /// Append alternative \a a of \a c
+        void push(const FloatChoice& c, unsigned int a);
+        /// Remove the last entry
+        void pop(void);
+        /// Return number of entries
+        int size(void) const;
+        /// Read entry \a i into \a c and \a a
+        void get(int i, FloatChoice& c, unsigned int& a) const;
+        /// Return the archived bytes
+        const unsigned char* data(void) const;
+        /// Return number of archived bytes
+        size_t bytes(void) const;
+      };
+
+      /**
+       * \brief %Branching description
+       *
+       * Besides the choice, which is relative to the views of the
+       * branching, the description knows the variable branched on in the
+       * space it was created for. Search engines use it to find the
+       * variable among the variables of the model.
+       */
       class FloatBranchingDesc : public BranchingDesc {
       private:
-        /// Value stored in the branching description.
-        double value;
+        /// The choice
+        FloatChoice c;
+        /// The variable branched on
+        FloatVarImp* v;
       public:
-        /**
-         * \brief Initialize description from branching \a b
-         * and float \a f.
-         */
-        FloatBranchingDesc(const Branching* b, const unsigned int a, double v);
-        /// Returns the float stored by the description
+        /// Initialize description from branching \a b, choice \a c and variable \a v
+        FloatBranchingDesc(const Branching* b, const FloatChoice& c,
+                           FloatVarImp* v);
+        /// Returns the size of the description
         virtual size_t size(void) const;
+        /// Returns the float stored by the description
         double val(void) const;
+        /// Return position of the view
+        int pos(void) const;
+        /// Return the choice
+        const FloatChoice& choice(void) const;
+        /// Return the variable branched on, in the space of the description
+        FloatVarImp* var(void) const;
       };
 
+      /**
+       * \brief Branching over a single float view
+       *
+       * Splits the view like FloatViewBranching does, by magnitude for
+       * wide or unbounded domains (see split()).
+       */
       template <bool inc>
       class FloatBranching : public Branching {
       private:
@@ -85,6 +208,72 @@ namespace Gecode {
         /// Perform cloning
         Actor* copy(Space* home, bool share);
       };
+
+      /**
+       * \brief Branching over an array of float views
+       *
+       * Views before \a start are assigned, so selection starts there.
+       * The selected view is split at its midpoint.
+       *
+       * Wide or unbounded domains are split by magnitude (see split()),
+       * and FLOAT_VAL_SPLIT_LAST splits at the last solution found by any
+       * clone sharing the branching, if it lies inside the domain.
+       *
+       * The smear of view \f$x_j\f$ in equation \f$f_i\f$ is
+       * \f$|\partial f_i/\partial x_j|\cdot w(x_j)\f$, with the derivative
+       * enclosed over the current box. Smear selections fall back to the
+       * largest domain if no equations are given.
+       */
+      class FloatViewBranching : public Branching {
+      protected:
+        typedef boost::numeric::interval<double> Interval;
+        /// The views to branch on
+        ViewArray<FloatView> x;
+        /// Further views of the equations
+        ViewArray<FloatView> y;
+        /// Equations for smear selection, bound to \a x followed by \a y
+        SharedArray<Equation> eqs;
+        /// Unassigned views start here
+        mutable int start;
+        /// Position of the view branched on last
+        int last;
+        /// Variable selection
+        FloatVarBranch vars;
+        /// Value selection
+        FloatValBranch vals;
+        /// Ratio for FLOAT_VAL_SPLIT_RATIO
+        double ratio;
+        /// Number of alternatives for FLOAT_VAL_SPLIT_K
+        unsigned int k;
+        /// Last solution found, followed by a flag whether there is one
+        mutable SharedArray<double> sol;
+        /// Return position of the selected view
+        int select(void) const;
+        /// Return position of the view with the largest smear
+        int smear(void) const;
+        /// Copy constructor
+        FloatViewBranching(Space* home, bool share, FloatViewBranching& b);
+      public:
+        /// Initialize from views \a x, further views \a y and equations \a eqs
+        FloatViewBranching(Space* home, ViewArray<FloatView>& x,
+                           ViewArray<FloatView>& y, SharedArray<Equation>& eqs,
+                           FloatVarBranch vars, FloatValBranch vals,
+                           double ratio, unsigned int k);
+        /// Returns the status of the branching
+        bool status(const Space* home) const;
+        /// Returns the choice of the branching, without allocation
+        FloatChoice choice(void) const;
+        /// Returns the description of the branching
+        const Gecode::BranchingDesc* description(const Space* home) const;
+        /// Commit for branching description \a d
+        ExecStatus commit(Space* home, const BranchingDesc* d, unsigned int a);
+        /// Commit to alternative \a a of choice \a c
+        ExecStatus commit(Space* home, const FloatChoice& c, unsigned int a);
+        /// Perform cloning
+        Actor* copy(Space* home, bool share);
+        /// Delete branching and return its size
+        size_t dispose(Space* home);
+      };
     }
   }
 }
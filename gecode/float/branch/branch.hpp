@@ -37,9 +37,127 @@
  */
 
 namespace Gecode { namespace Float { namespace Branch {
+
+  /// Ratio of the bounds above which a domain is split by magnitude
+  const double split_wide = 1e3;
+
+  forceinline double
+  split(double l, double u, bool mag) {
+    const double inf = std::numeric_limits<double>::infinity();
+    const double big = std::numeric_limits<double>::max();
+    if ((l == -inf) && (u == inf))
+      return 0.0;
+    if (l == -inf) {
+      double v = u - std::max(1.0,std::abs(u));
+      return (v > -inf) ? v : -big;
+    }
+    if (u == inf) {
+      double v = l + std::max(1.0,std::abs(l));
+      return (v < inf) ? v : big;
+    }
+    // Halving each bound first cannot overflow
+    double v = l / 2.0 + u / 2.0;
+    if (mag) {
+      if ((l > 0.0) && (u > split_wide * l))
+        v = std::sqrt(l) * std::sqrt(u);
+      else if ((u < 0.0) && (l < split_wide * u))
+        v = -std::sqrt(-l) * std::sqrt(-u);
+      else if ((l < -1.0) && (u > 1.0) &&
+               (u / 2.0 - l / 2.0 > split_wide / 2.0 * std::min(-l,u)))
+        v = 0.0;
+    }
+    if (!((l < v) && (v < u)))
+      v = l / 2.0 + u / 2.0;
+    return std::min(std::max(v,l),u);
+  }
+
+  forceinline double
+  part(double l, double u, unsigned int a, unsigned int n) {
+    double t = static_cast<double>(a) / n;
+    return std::min(std::max(l * (1.0 - t) + u * t,l),u);
+  }
+
+  forceinline void
+  bounds(const FloatChoice& c, unsigned int a, double& l, double& u) {
+    if (c.alt > 2) {
+      // Part a of the parts starting at the stored lower bound
+      double h = u;
+      if (a > 0)
+        l = part(c.val,h,a,c.alt);
+      if (a+1 < c.alt)
+        u = part(c.val,h,a+1,c.alt);
+    } else if ((a == 0) != c.upper) {
+      u = c.val;
+    } else {
+      l = c.val;
+    }
+  }
+
+  forceinline ExecStatus
+  commit(Space* home, FloatView x, const FloatChoice& c, unsigned int a) {
+    double l = x.min(), u = x.max();
+    bounds(c,a,l,u);
+    GECODE_ME_CHECK(x.gq(home,l));
+    GECODE_ME_CHECK(x.lq(home,u));
+    return ES_OK;
+  }
+
+  /*
+   * \FloatPath
+   *
+   */
+
+  forceinline
+  FloatPath::FloatPath(void) {}
+
+  forceinline
+  FloatPath::FloatPath(const unsigned char* d, size_t n)
+    : b(d,d+n) {}
+
+  forceinline void
+  FloatPath::push(const FloatChoice& c, unsigned int a) {
+    size_t n = b.size();
+    b.resize(n + entry);
+    std::memcpy(&b[n],&c,sizeof(FloatChoice));
+    std::memcpy(&b[n+sizeof(FloatChoice)],&a,sizeof(unsigned int));
+  }
+
+  forceinline void
+  FloatPath::pop(void) {
+    b.resize(b.size() - entry);
+  }
+
+  forceinline int
+  FloatPath::size(void) const {
+    return static_cast<int>(b.size() / entry);
+  }
+
+  forceinline void
+  FloatPath::get(int i, FloatChoice& c, unsigned int& a) const {
+    std::memcpy(&c,&b[i*entry],sizeof(FloatChoice));
+    std::memcpy(&a,&b[i*entry+sizeof(FloatChoice)],sizeof(unsigned int));
+  }
+
+  forceinline const unsigned char*
+  FloatPath::data(void) const {
+    return b.empty() ? NULL : &b[0];
+  }
+
+  forceinline size_t
+  FloatPath::bytes(void) const {
+    return b.size();
+  }
+
+  /*
+   * \FloatBranchingDesc
+   *
+   */
+
   forceinline
-  FloatBranchingDesc::FloatBranchingDesc(const Branching* b,const unsigned int a,double v)
-    : BranchingDesc(b,a) , value(v) {}
+  FloatBranchingDesc::FloatBranchingDesc(const Branching* b,
+                                         const FloatChoice& c0,
+                                         FloatVarImp* v0)
+    : BranchingDesc(b,c0.alt) , c(c0), v(v0) {}
 
   forceinline size_t
   FloatBranchingDesc::size(void) const {
@@ -48,7 +166,22 @@ namespace Gecode { namespace Float { namespace Branch {
 
   forceinline double
   FloatBranchingDesc::val(void) const {
-    return value;
+    return c.val;
+  }
+
+  forceinline int
+  FloatBranchingDesc::pos(void) const {
+    return c.pos;
+  }
+
+  forceinline const FloatChoice&
+  FloatBranchingDesc::choice(void) const {
+    return c;
+  }
+
+  forceinline FloatVarImp*
+  FloatBranchingDesc::var(void) const {
+    return v;
   }
 
   /*
@@ -78,11 +211,8 @@ namespace Gecode { namespace Float { namespace Branch {
   template <bool inc>
   forceinline ExecStatus
   FloatBranching<inc>::commit(Space* home, const BranchingDesc* d, unsigned int a) {
-    const FloatBranchingDesc *bd = dynamic_cast<const FloatBranchingDesc*>(d);
-    if ((a == 0) == inc) {
-      return me_failed(f.lq(home, bd->val())) ? ES_FAILED : ES_OK;
-    }
-    return me_failed(f.gq(home, bd->val())) ? ES_FAILED : ES_OK;
+    const FloatBranchingDesc *bd = static_cast<const FloatBranchingDesc*>(d);
+    return Branch::commit(home, f, bd->choice(), a);
   }
 
   template <bool inc>
@@ -94,8 +224,193 @@ namespace Gecode { namespace Float { namespace Branch {
       template <bool inc>
       forceinline const Gecode::BranchingDesc*
       FloatBranching<inc>::description(const Space* home) const {
-        return new FloatBranchingDesc(this , 2, f.med());
+        FloatChoice c = { 0, 2, split(f.min(),f.max(),true), !inc };
+        return new FloatBranchingDesc(this,c,f.var());
+      }
+
+  /*
+   * \FloatViewBranching
+   *
+   */
+
+  forceinline
+  FloatViewBranching::FloatViewBranching(Space* home, ViewArray<FloatView>& x0,
+                                         ViewArray<FloatView>& y0,
+                                         SharedArray<Equation>& eqs0,
+                                         FloatVarBranch vars0,
+                                         FloatValBranch vals0,
+                                         double ratio0, unsigned int k0)
+    : Branching(home), x(x0), y(y0), eqs(eqs0), start(0), last(-1),
+      vars(vars0), vals(vals0), ratio(ratio0), k(k0), sol(x0.size()+1) {
+    sol[x.size()] = 0.0;
+    home->notice(this,AP_DISPOSE);
+  }
+
+  forceinline
+  FloatViewBranching::FloatViewBranching(Space* home, bool share,
+                                         FloatViewBranching& b)
+    : Branching(home,share,b), start(b.start), last(b.last),
+      vars(b.vars), vals(b.vals), ratio(b.ratio), k(b.k) {
+    x.update(home,share,b.x);
+    y.update(home,share,b.y);
+    eqs.update(home,share,b.eqs);
+    sol.update(home,share,b.sol);
+  }
+
+  forceinline Actor*
+  FloatViewBranching::copy(Space* home, bool share) {
+    return new (home) FloatViewBranching(home,share,*this);
+  }
+
+  forceinline size_t
+  FloatViewBranching::dispose(Space* home) {
+    home->ignore(this,AP_DISPOSE);
+    eqs.~SharedArray();
+    sol.~SharedArray();
+    (void) Branching::dispose(home);
+    return sizeof(*this);
+  }
+
+  forceinline bool
+  FloatViewBranching::status(const Space*) const {
+    while ((start < x.size()) && x[start].assigned())
+      start++;
+    if (start < x.size())
+      return true;
+    // All views are assigned: remember the solution
+    for (int i = x.size(); i--; )
+      sol[i] = x[i].med();
+    sol[x.size()] = 1.0;
+    return false;
+  }
+
+  forceinline int
+  FloatViewBranching::smear(void) const {
+    int n = x.size(), m = y.size();
+    Box b(n+m);
+    for (int i = n; i--; )
+      b[i] = Interval(x[i].min(),x[i].max());
+    for (int i = m; i--; )
+      b[n+i] = Interval(y[i].min(),y[i].max());
+    std::vector<double> score(n,0.0), s(n);
+    for (int e = eqs.size(); e--; ) {
+      double t = 0.0;
+      for (int i = start; i < n; i++) {
+        s[i] = x[i].assigned() ? 0.0 :
+          norm(eqs[e].derivative(i,b)) * width(b[i]);
+        t += s[i];
+      }
+      for (int i = start; i < n; i++)
+        if (vars == FLOAT_VAR_SMEAR_SUM)
+          score[i] += s[i];
+        else if (t > 0.0)
+          score[i] = std::max(score[i],s[i] / t);
+    }
+    int p = start;
+    for (int i = start; i < n; i++)
+      if (!x[i].assigned() && (x[p].assigned() || (score[i] > score[p])))
+        p = i;
+    if (score[p] > 0.0)
+      return p;
+    // Without information from the equations use the largest domain
+    for (int i = start; i < n; i++)
+      if (!x[i].assigned() &&
+          (x[i].max() - x[i].min() > x[p].max() - x[p].min()))
+        p = i;
+    return p;
+  }
+
+  forceinline int
+  FloatViewBranching::select(void) const {
+    int n = x.size();
+    switch (vars) {
+    case FLOAT_VAR_SMEAR_SUM:
+    case FLOAT_VAR_SMEAR_MAX_REL:
+      return smear();
+    case FLOAT_VAR_ROUND_ROBIN:
+      for (int i = 1; i <= n; i++) {
+        int j = (last + i) % n;
+        if ((j >= start) && !x[j].assigned())
+          return j;
       }
+      return start;
+    case FLOAT_VAR_SIZE_MIN:
+    case FLOAT_VAR_SIZE_MAX:
+    case FLOAT_VAR_WIDTH_REL_MAX:
+      {
+        int b = start;
+        double bw = 0.0;
+        for (int i = start; i < n; i++) {
+          if (x[i].assigned())
+            continue;
+          double w = x[i].max() - x[i].min();
+          if (vars == FLOAT_VAR_WIDTH_REL_MAX)
+            w /= std::max(1.0,std::max(std::abs(x[i].min()),
+                                       std::abs(x[i].max())));
+          if ((i == start) ||
+              ((vars == FLOAT_VAR_SIZE_MIN) ? (w < bw) : (w > bw))) {
+            b = i; bw = w;
+          }
+        }
+        return b;
+      }
+    default:
+      return start;
+    }
+  }
+
+  forceinline FloatChoice
+  FloatViewBranching::choice(void) const {
+    FloatChoice c;
+    c.pos = select(); c.alt = 2; c.upper = (vals == FLOAT_VAL_SPLIT_MAX);
+    double l = x[c.pos].min(), u = x[c.pos].max();
+    switch (vals) {
+    case FLOAT_VAL_SPLIT_RATIO:
+      c.val = l + ratio * (u - l);
+      if (!((l < c.val) && (c.val < u)))
+        c.val = split(l,u,false);
+      break;
+    case FLOAT_VAL_SPLIT_MAG:
+      c.val = split(l,u,true);
+      break;
+    case FLOAT_VAL_SPLIT_K:
+      if ((l > -std::numeric_limits<double>::max()) &&
+          (u < std::numeric_limits<double>::max())) {
+        c.alt = k; c.val = l;
+      } else {
+        c.val = split(l,u,true);
+      }
+      break;
+    case FLOAT_VAL_SPLIT_LAST:
+      c.val = sol[c.pos];
+      if ((sol[x.size()] == 0.0) || !((l < c.val) && (c.val < u)))
+        c.val = split(l,u,false);
+      break;
+    default:
+      c.val = split(l,u,false);
+      break;
+    }
+    return c;
+  }
+
+  forceinline const Gecode::BranchingDesc*
+  FloatViewBranching::description(const Space*) const {
+    FloatChoice c = choice();
+    return new FloatBranchingDesc(this,c,x[c.pos].var());
+  }
+
+  forceinline ExecStatus
+  FloatViewBranching::commit(Space* home, const FloatChoice& c,
+                             unsigned int a) {
+    last = c.pos;
+    return Branch::commit(home,x[c.pos],c,a);
+  }
+
+  forceinline ExecStatus
+  FloatViewBranching::commit(Space* home, const BranchingDesc* d,
+                             unsigned int a) {
+    return commit(home,static_cast<const FloatBranchingDesc*>(d)->choice(),a);
+  }
 
     }
   }
@@ -106,4 +421,78 @@ namespace Gecode { namespace Float { namespace Branch {
     Float::FloatView fv(f);
     (void) new (home) Float::Branch::FloatBranching<true>(home,fv);
   }
+
+  /**
+   * \brief Branch over \a x with variable selection \a vars and value
+   * selection \a vals
+   *
+   * \a ratio is used by FLOAT_VAL_SPLIT_RATIO and must lie in
+   * \f$(0,1)\f$, \a k is the number of alternatives of FLOAT_VAL_SPLIT_K
+   * and must be at least two.
+   */
+  forceinline void
+  branch(Space* home, const FloatVarArgs& x, FloatVarBranch vars,
+         FloatValBranch vals, double ratio=0.5, unsigned int k=2) {
+    if (!((ratio > 0.0) && (ratio < 1.0)) || (k < 2))
+      throw Float::OutOfLimits("Float::branch");
+    if (home->failed()) return;
+    ViewArray<Float::FloatView> xv(home,x), yv(home,0);
+    SharedArray<Float::Equation> eqs(0);
+    (void) new (home) Float::Branch::FloatViewBranching(home,xv,yv,eqs,
+                                                        vars,vals,ratio,k);
+  }
+
+  /**
+   * \brief Branch over \a x, using the equations \a e for smear selection
+   *
+   * The equations may contain further variables, which are not branched on.
+   */
+  forceinline void
+  branch(Space* home, const FloatVarArgs& x, const EquationArgs& e,
+         FloatVarBranch vars, FloatValBranch vals, double ratio=0.5,
+         unsigned int k=2) {
+    if (!((ratio > 0.0) && (ratio < 1.0)) || (k < 2))
+      throw Float::OutOfLimits("Float::branch");
+    if (home->failed()) return;
+    Float::VarIndex vi;
+    for (int i = 0; i < x.size(); i++)
+      (void) vi.index(x[i].var());
+    if (vi.size() != x.size())
+      throw Float::ArgumentSame("Float::branch");
+    SharedArray<Float::Equation> eqs(e.size());
+    for (int i = e.size(); i--; ) {
+      eqs[i] = e[i];
+      eqs[i].bind(vi);
+    }
+    ViewArray<Float::FloatView> xv(home,x), yv(home,vi.size()-x.size());
+    for (int i = yv.size(); i--; )
+      yv[i] = Float::FloatView(vi[x.size()+i]);
+    (void) new (home) Float::Branch::FloatViewBranching(home,xv,yv,eqs,
+                                                        vars,vals,ratio,k);
+  }
+
+  /**
+   * \brief Replay the choices of path \a p on \a home
+   *
+   * \a x are the variables branched on, in the order given to branch(),
+   * and \a home must be in the state the path starts from. The views are
+   * committed directly, so the position of FLOAT_VAR_ROUND_ROBIN in the
+   * branching of \a home is not advanced.
+   */
+  forceinline void
+  replay(Space* home, const FloatVarArgs& x,
+         const Float::Branch::FloatPath& p) {
+    for (int i = 0; i < p.size(); i++) {
+      if (home->status() == SS_FAILED)
+        return;
+      Float::Branch::FloatChoice c;
+      unsigned int a;
+      p.get(i,c,a);
+      if (Float::Branch::commit(home,Float::FloatView(x[c.pos]),c,a)
+          == ES_FAILED) {
+        home->fail();
+        return;
+      }
+    }
+  }
 }
@@ -0,0 +1,95 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef __GECODE_FLOAT_CHANNEL_HH__
+#define __GECODE_FLOAT_CHANNEL_HH__
+
+#include <gecode/float/float.hh>
+#include <gecode/int.hh>
+
+namespace Gecode {
+  namespace Float {
+
+    /*
+     * Integer channeling
+     *
+     */
+
+    /// Relation between an integer and a float variable
+    enum RoundType {
+      RT_EQ,    ///< \f$y=x\f$
+      RT_FLOOR, ///< \f$y=\lfloor x\rfloor\f$
+      RT_CEIL,  ///< \f$y=\lceil x\rceil\f$
+      RT_ROUND  ///< \f$y=\lfloor x+1/2\rfloor\f$
+    };
+
+    /**
+     * \brief Propagator for \f$y=r(x)\f$ with float \a x and integer \a y
+     *
+     * The bounds of \a x are rounded into bounds of \a y, and the bounds
+     * of \a y give the closed hull of the floats rounding into them.
+     */
+    template <class View, RoundType rt>
+    class Round :
+      public MixBinaryPropagator<View,PC_FLOAT_BND,Int::IntView,Int::PC_INT_BND> {
+    protected:
+      using MixBinaryPropagator<View,PC_FLOAT_BND,Int::IntView,Int::PC_INT_BND>::x0;
+      using MixBinaryPropagator<View,PC_FLOAT_BND,Int::IntView,Int::PC_INT_BND>::x1;
+      /// Return smallest integer for floats not less than \a v
+      static int lower(double v);
+      /// Return largest integer for floats not greater than \a v
+      static int upper(double v);
+      /// Constructor for cloning \a p
+      Round(Space* home, bool share, Round& p);
+      /// Constructor for posting
+      Round(Space* home, View x, Int::IntView y);
+    public:
+      /// Copy propagator during cloning
+      virtual Actor* copy(Space* home, bool share);
+      /// Perform propagation
+      virtual ExecStatus propagate(Space* home, ModEventDelta med);
+      /// Post propagator for \f$y=r(x)\f$
+      static  ExecStatus post(Space* home, View x, Int::IntView y);
+    };
+
+  }
+}
+
+#include <gecode/float/channel/channel.hpp>
+
+#endif
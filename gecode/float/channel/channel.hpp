@@ -0,0 +1,182 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <cmath>
+
+namespace Gecode {
+  namespace Float {
+
+    /*
+     * Integer channeling
+     *
+     */
+
+    /// Return \a v clamped to the integer limits
+    forceinline int
+    clamp(double v) {
+      if (v <= Int::Limits::min)
+        return Int::Limits::min;
+      if (v >= Int::Limits::max)
+        return Int::Limits::max;
+      return static_cast<int>(v);
+    }
+
+    template <class View, RoundType rt>
+    forceinline
+    Round<View,rt>::Round(Space* home, View x, Int::IntView y)
+      : MixBinaryPropagator<View,PC_FLOAT_BND,Int::IntView,Int::PC_INT_BND>
+        (home,x,y) {}
+
+    template <class View, RoundType rt>
+    forceinline
+    Round<View,rt>::Round(Space* home, bool share, Round& p)
+      : MixBinaryPropagator<View,PC_FLOAT_BND,Int::IntView,Int::PC_INT_BND>
+        (home,share,p) {}
+
+    template <class View, RoundType rt>
+    Actor*
+    Round<View,rt>::copy(Space* home, bool share) {
+      return new (home) Round<View,rt>(home,share,*this);
+    }
+
+    template <class View, RoundType rt>
+    forceinline int
+    Round<View,rt>::lower(double v) {
+      switch (rt) {
+      case RT_EQ:
+      case RT_CEIL:
+        return clamp(std::ceil(v));
+      case RT_FLOOR:
+        return clamp(std::floor(v));
+      default:
+        {
+          // v+1/2 may round up onto the next integer
+          double f = std::floor(v + 0.5);
+          if (f - 0.5 > v)
+            f -= 1.0;
+          return clamp(f);
+        }
+      }
+    }
+
+    template <class View, RoundType rt>
+    forceinline int
+    Round<View,rt>::upper(double v) {
+      switch (rt) {
+      case RT_EQ:
+      case RT_FLOOR:
+        return clamp(std::floor(v));
+      case RT_CEIL:
+        return clamp(std::ceil(v));
+      default:
+        return clamp(std::floor(v + 0.5));
+      }
+    }
+
+    template <class View, RoundType rt>
+    ExecStatus
+    Round<View,rt>::propagate(Space* home, ModEventDelta) {
+      GECODE_ME_CHECK(x1.gq(home,lower(x0.min())));
+      GECODE_ME_CHECK(x1.lq(home,upper(x0.max())));
+      // Closed hull of the floats rounding into the bounds of y
+      double l = x1.min(), u = x1.max();
+      switch (rt) {
+      case RT_EQ:    break;
+      case RT_FLOOR: u += 1.0; break;
+      case RT_CEIL:  l -= 1.0; break;
+      default:       l -= 0.5; u += 0.5; break;
+      }
+      GECODE_ME_CHECK(x0.gq(home,l));
+      GECODE_ME_CHECK(x0.lq(home,u));
+      if (x1.assigned() && (lower(x0.min()) == x1.val()) &&
+          (upper(x0.max()) == x1.val()))
+        return ES_SUBSUMED(this,home);
+      return ES_FIX;
+    }
+
+    template <class View, RoundType rt>
+    ExecStatus
+    Round<View,rt>::post(Space* home, View x, Int::IntView y) {
+      (void) new (home) Round<View,rt>(home,x,y);
+      return ES_OK;
+    }
+
+  }
+
+  /*
+   * Constraints
+   *
+   */
+
+  /// Post \f$x=y\f$ for float \a x and integer \a y
+  forceinline void
+  channel(Space* home, IntVar y, FloatVar x) {
+    if (home->failed()) return;
+    if (Float::Round<Float::FloatView,Float::RT_EQ>
+        ::post(home,x,y) != ES_OK)
+      home->fail();
+  }
+
+  /// Post \f$y=\lfloor x\rfloor\f$
+  forceinline void
+  floor(Space* home, FloatVar x, IntVar y) {
+    if (home->failed()) return;
+    if (Float::Round<Float::FloatView,Float::RT_FLOOR>
+        ::post(home,x,y) != ES_OK)
+      home->fail();
+  }
+
+  /// Post \f$y=\lceil x\rceil\f$
+  forceinline void
+  ceil(Space* home, FloatVar x, IntVar y) {
+    if (home->failed()) return;
+    if (Float::Round<Float::FloatView,Float::RT_CEIL>
+        ::post(home,x,y) != ES_OK)
+      home->fail();
+  }
+
+  /// Post \f$y=\lfloor x+1/2\rfloor\f$ (halves round up)
+  forceinline void
+  round(Space* home, FloatVar x, IntVar y) {
+    if (home->failed()) return;
+    if (Float::Round<Float::FloatView,Float::RT_ROUND>
+        ::post(home,x,y) != ES_OK)
+      home->fail();
+  }
+
+}
@@ -54,6 +54,30 @@ namespace Gecode {
     class Equation;
   }
 
+  /**
+   * \brief Evaluation mode of equations
+   *
+   * \ingroup CpFloatVars
+   */
+  enum FloatEvalMode {
+    FEM_NATURAL, ///< Natural interval extension
+    FEM_AFFINE   ///< Affine forms for the residual test and a first projection
+  };
+
+  /**
+   * \brief Relation types for floats
+   *
+   * The complement of a relation is propagated as its closed hull, so
+   * the negation of \f$x\leq y\f$ is propagated as \f$x\geq y\f$.
+   *
+   * \ingroup CpFloatVars
+   */
+  enum FloatRelType {
+    FRT_EQ, ///< Equality (\f$=\f$)
+    FRT_LQ, ///< Less or equal (\f$\leq\f$)
+    FRT_GQ  ///< Greater or equal (\f$\geq\f$)
+  };
+
   /**
    * \brief Float variables.
    *
@@ -109,8 +133,16 @@ namespace Gecode {
 
     Float::Operation operator+(FloatVar exp);
     Float::Operation operator+(Float::Operation exp);
+    Float::Operation operator-(FloatVar exp);
+    Float::Operation operator-(Float::Operation exp);
+    Float::Operation operator*(FloatVar exp);
+    Float::Operation operator*(Float::Operation exp);
+    Float::Operation operator+(double c);
+    Float::Operation operator-(double c);
+    Float::Operation operator*(double c);
     Float::Equation  operator=(FloatVar exp);
     Float::Equation  operator=(Float::Operation exp);
+    Float::Equation  operator=(double c);
 
     void propagation(double l,double u);
     void show();
@@ -137,6 +169,10 @@ namespace Gecode {
   //@{
   /// Passing integer variables
   typedef VarArgArray<FloatVar>  FloatVarArgs;
+  /// Passing float values
+  typedef PrimArgArray<double> FloatArgs;
+  /// Passing equations
+  typedef PrimArgArray<Float::Equation> EquationArgs;
   //@}
 
   /**
@@ -0,0 +1,598 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef __GECODE_FLOAT_GLOBAL_HH__
+#define __GECODE_FLOAT_GLOBAL_HH__
+
+#include <gecode/float/float.hh>
+#include <gecode/float/arith.hh>
+#include <gecode/int.hh>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace Gecode {
+  namespace Float {
+
+    /*
+     * Interval Newton contractor
+     *
+     */
+
+    /**
+     * \brief Interval Newton contractor for square systems of equations
+     *
+     * Performs preconditioned interval Gauss-Seidel (Hansen-Sengupta)
+     * steps for the equations over the first \a n views. The remaining
+     * views are parameters of the equations. If a step maps the box into
+     * its interior, the box contains exactly one root and \a u is set
+     * to one.
+     */
+    template <class View>
+    class Newton : public Propagator {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
+      /// Unknowns followed by the parameters of the equations
+      ViewArray<View> x;
+      /// Number of unknowns (and equations)
+      int n;
+      /// The equations, bound to the positions of \a x
+      SharedArray<Equation> eqs;
+      /// Set to one once the box is proven to hold a unique root
+      Int::BoolView u;
+      /// Constructor for cloning \a p
+      Newton(Space* home, bool share, Newton& p);
+      /// Constructor for posting
+      Newton(Space* home, ViewArray<View>& x, int n,
+             SharedArray<Equation>& eqs, Int::BoolView u);
+    public:
+      /// Copy propagator during cloning
+      virtual Actor* copy(Space* home, bool share);
+      /// Perform propagation
+      virtual ExecStatus propagate(Space* home, ModEventDelta med);
+      /// Cost function (cubic in the number of unknowns)
+      virtual PropCost cost(ModEventDelta med) const;
+      /// Delete propagator and return its size
+      virtual size_t dispose(Space* home);
+      /// Post propagator for equations \a e over unknowns \a y
+      static  ExecStatus post(Space* home, const EquationArgs& e,
+                              const FloatVarArgs& y, Int::BoolView u);
+    };
+
+    /*
+     * Linear systems
+     *
+     */
+
+    /**
+     * \brief Interval Gauss-Seidel propagator for linear systems \f$Ax=b\f$
+     *
+     * The matrix is kept in compressed sparse row (CSR) form with interval
+     * entries. Square systems are preconditioned at post time block
+     * Jacobi style: the rows of each diagonal block of at most
+     * linear_precondition_limit rows are multiplied by the inverse of the
+     * midpoint of that block. A system with a single block is thus
+     * preconditioned with the inverse of \f$A\f$, while the fill of
+     * larger systems stays within the rows of a block. Each propagation
+     * projects every row onto all of its variables in a single sweep.
+     */
+    template <class View>
+    class LinearSystem : public Propagator {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
+      /// The variables
+      ViewArray<View> x;
+      /// Offset of the first nonzero of each row (one more than rows)
+      SharedArray<int> row;
+      /// Column of each nonzero
+      SharedArray<int> col;
+      /// Value of each nonzero
+      SharedArray<Interval> a;
+      /// Right hand side of each row
+      SharedArray<Interval> b;
+      /// Constructor for cloning \a p
+      LinearSystem(Space* home, bool share, LinearSystem& p);
+      /// Constructor for posting
+      LinearSystem(Space* home, ViewArray<View>& x, SharedArray<int>& row,
+                   SharedArray<int>& col, SharedArray<Interval>& a,
+                   SharedArray<Interval>& b);
+    public:
+      /// Copy propagator during cloning
+      virtual Actor* copy(Space* home, bool share);
+      /// Perform propagation
+      virtual ExecStatus propagate(Space* home, ModEventDelta med);
+      /// Cost function (linear in the number of nonzeros)
+      virtual PropCost cost(ModEventDelta med) const;
+      /// Delete propagator and return its size
+      virtual size_t dispose(Space* home);
+      /// Post propagator for \f$Ax=b\f$ with \a a given row-major
+      static  ExecStatus post(Space* home, const FloatArgs& a,
+                              const FloatVarArgs& y, const FloatArgs& b);
+      /**
+       * \brief Post propagator for \f$Ax=b\f$ with \a a given as triplets
+       *
+       * Entry \f$k\f$ adds \a v[k] to \f$A_{r[k],c[k]}\f$.
+       */
+      static  ExecStatus post(Space* home, const IntArgs& r,
+                              const IntArgs& c, const FloatArgs& v,
+                              const FloatVarArgs& y, const FloatArgs& b);
+    };
+
+    /*
+     * Shaving (3B consistency)
+     *
+     */
+
+    /**
+     * \brief Shaving propagator enforcing 3B consistency
+     *
+     * Tries slices at both bounds of the first \a n views and removes the
+     * slices that HC4 over the equations refutes. At most \a budget slices
+     * are tried per propagation. In adaptive mode the number of variables
+     * shaved per propagation grows while shaving pays off and shrinks
+     * otherwise, in the style of CID/ACID. Variables with an infinite
+     * bound are not shaved. The propagator reports no fixpoint until a
+     * sweep over all shaved variables leaves the bounds unchanged.
+     */
+    template <class View>
+    class Shave : public Propagator {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
+      /// Shaved variables followed by the other variables of the equations
+      ViewArray<View> x;
+      /// Number of shaved variables
+      int n;
+      /// The equations, bound to the positions of \a x
+      SharedArray<Equation> eqs;
+      /// Slice width as a fraction of the domain width
+      double slice;
+      /// Maximal number of slices tried per propagation
+      int budget;
+      /// Whether the number of shaved variables is adapted
+      bool adaptive;
+      /// Number of variables shaved per propagation
+      int active;
+      /// Variable to start shaving with
+      int start;
+      /// Number of variables shaved since a bound last moved
+      int idle;
+      /// Constructor for cloning \a p
+      Shave(Space* home, bool share, Shave& p);
+      /// Constructor for posting
+      Shave(Space* home, ViewArray<View>& x, int n,
+            SharedArray<Equation>& eqs, double slice, int budget,
+            bool adaptive);
+    public:
+      /// Copy propagator during cloning
+      virtual Actor* copy(Space* home, bool share);
+      /// Perform propagation
+      virtual ExecStatus propagate(Space* home, ModEventDelta med);
+      /// Cost function
+      virtual PropCost cost(ModEventDelta med) const;
+      /// Delete propagator and return its size
+      virtual size_t dispose(Space* home);
+      /// Post propagator for equations \a e shaving \a y
+      static  ExecStatus post(Space* home, const EquationArgs& e,
+                              const FloatVarArgs& y, double slice,
+                              int budget, bool adaptive);
+    };
+
+    /*
+     * Monotonicity-based contractor (Mohc)
+     *
+     */
+
+    /**
+     * \brief Monotonicity-based contractor for one equation
+     *
+     * Checks the sign of the derivatives over the current box. If the
+     * equation is monotone in some variables, their domains are narrowed
+     * using the MinMax test and MonotonicBoxNarrow on the corner functions
+     * \f$f_{min}\f$ and \f$f_{max}\f$. Otherwise only HC4 is applied.
+     */
+    template <class View>
+    class Mohc : public Propagator {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
+      /// The variables of the equation
+      ViewArray<View> x;
+      /// The equation, bound to the positions of \a x
+      SharedArray<Equation> eq;
+      /// Constructor for cloning \a p
+      Mohc(Space* home, bool share, Mohc& p);
+      /// Constructor for posting
+      Mohc(Space* home, ViewArray<View>& x, SharedArray<Equation>& eq);
+      /// Narrow \a b by MinMax and MonotonicBoxNarrow, false if empty
+      bool narrow(Box& b) const;
+    public:
+      /// Copy propagator during cloning
+      virtual Actor* copy(Space* home, bool share);
+      /// Perform propagation
+      virtual ExecStatus propagate(Space* home, ModEventDelta med);
+      /// Cost function
+      virtual PropCost cost(ModEventDelta med) const;
+      /// Delete propagator and return its size
+      virtual size_t dispose(Space* home);
+      /// Post propagator for equation \a e
+      static  ExecStatus post(Space* home, Equation e);
+    };
+
+    /*
+     * Linear relaxation
+     *
+     */
+
+    /**
+     * \brief Dense simplex solver for \f$\max c^Tx\f$ s.t. \f$Ax\le b, x\ge 0\f$
+     *
+     * Two-phase tableau method; negative right hand sides are handled by
+     * one artificial variable in the first phase. Results are floating
+     * point approximations, rigorous bounds must be derived from the
+     * dual values.
+     */
+    class Simplex {
+    protected:
+      /// Number of rows and columns
+      int m, n;
+      /// Variables in the basis (one per row)
+      std::vector<int> bv;
+      /// Variables not in the basis (one per column, plus the artificial)
+      std::vector<int> nv;
+      /// Tableau with \a m+2 rows and \a n+2 columns
+      std::vector<double> d;
+      /// Return tableau entry at row \a i and column \a j
+      double& at(int i, int j);
+      /// Pivot on row \a r and column \a s
+      void pivot(int r, int s);
+      /// Run simplex iterations of phase \a p, false if unbounded
+      bool iterate(int p);
+    public:
+      /// Initialize for \a a (row-major), \a b, and \a c
+      Simplex(const std::vector<double>& a, const std::vector<double>& b,
+              const std::vector<double>& c);
+      /// Solve, returns false if infeasible, unbounded, or not converged
+      bool solve(void);
+      /// Return the (nonnegative) dual value of row \a i
+      double dual(int i);
+    };
+
+    /**
+     * \brief Polytope hull contractor based on a linear relaxation
+     *
+     * Every \a freq-th propagation linearizes all equations over the
+     * current box by a first-order Taylor form with interval remainder
+     * and computes, for every variable, its minimum and maximum over the
+     * relaxation with Simplex. The bounds are made rigorous from the
+     * dual values (Neumaier-Shcherbina), so all variables are contracted
+     * at once without trusting the floating point optimum.
+     */
+    template <class View>
+    class Polytope : public Propagator {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
+      /// The variables of the equations
+      ViewArray<View> x;
+      /// The equations, bound to the positions of \a x
+      SharedArray<Equation> eqs;
+      /// Run every \a freq propagations
+      int freq;
+      /// Number of propagations so far
+      int calls;
+      /// Constructor for cloning \a p
+      Polytope(Space* home, bool share, Polytope& p);
+      /// Constructor for posting
+      Polytope(Space* home, ViewArray<View>& x, SharedArray<Equation>& eqs,
+               int freq);
+    public:
+      /// Copy propagator during cloning
+      virtual Actor* copy(Space* home, bool share);
+      /// Perform propagation
+      virtual ExecStatus propagate(Space* home, ModEventDelta med);
+      /// Cost function
+      virtual PropCost cost(ModEventDelta med) const;
+      /// Delete propagator and return its size
+      virtual size_t dispose(Space* home);
+      /// Post propagator for equations \a e
+      static  ExecStatus post(Space* home, const EquationArgs& e, int freq);
+    };
+
+    /*
+     * Bernstein expansion
+     *
+     */
+
+    /**
+     * \brief Polynomial equation propagated by Bernstein expansion
+     *
+     * Keeps the Bernstein coefficients of the polynomial over a box
+     * enclosing the current domains. Their hull encloses the range of the
+     * polynomial, and the convex hull of the control points narrows each
+     * variable. When the domains shrink the coefficients are restricted
+     * by de Casteljau subdivision instead of being recomputed, and clones
+     * inherit the coefficients of the node they are cloned from.
+     */
+    template <class View>
+    class Bernstein : public Propagator {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
+      /// The variables of the polynomial
+      ViewArray<View> x;
+      /// Degree in each variable
+      SharedArray<int> deg;
+      /// Box the coefficients belong to
+      Box pb;
+      /// Bernstein coefficients, first variable varying fastest
+      std::vector<Interval> coef;
+      /// Restrict the coefficients to the current domains
+      void restrict(void);
+      /// Constructor for cloning \a p
+      Bernstein(Space* home, bool share, Bernstein& p);
+      /// Constructor for posting
+      Bernstein(Space* home, ViewArray<View>& x, SharedArray<int>& deg,
+                const Box& pb, const std::vector<Interval>& coef);
+    public:
+      /// Copy propagator during cloning
+      virtual Actor* copy(Space* home, bool share);
+      /// Perform propagation
+      virtual ExecStatus propagate(Space* home, ModEventDelta med);
+      /// Cost function
+      virtual PropCost cost(ModEventDelta med) const;
+      /// Delete propagator and return its size
+      virtual size_t dispose(Space* home);
+      /// Post propagator for polynomial equation \a e
+      static  ExecStatus post(Space* home, Equation e);
+    };
+
+    /*
+     * Distance
+     *
+     */
+
+    /**
+     * \brief Euclidean distance \f$d=\|p-q\|\f$ between two points
+     *
+     * Propagates on the coordinate differences: \f$d\f$ is bounded by the
+     * nearest and farthest points of the boxes, and each difference is
+     * projected onto the ball of radius \f$\max(d)\f$ and out of the ball
+     * of radius \f$\min(d)\f$ (annulus), given the other differences.
+     */
+    template <class View>
+    class Distance : public Propagator {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
+      /// Coordinates of the first point
+      ViewArray<View> p;
+      /// Coordinates of the second point
+      ViewArray<View> q;
+      /// The distance
+      View d;
+      /// Constructor for cloning \a pr
+      Distance(Space* home, bool share, Distance& pr);
+      /// Constructor for posting
+      Distance(Space* home, ViewArray<View>& p, ViewArray<View>& q, View d);
+    public:
+      /// Copy propagator during cloning
+      virtual Actor* copy(Space* home, bool share);
+      /// Perform propagation
+      virtual ExecStatus propagate(Space* home, ModEventDelta med);
+      /// Cost function
+      virtual PropCost cost(ModEventDelta med) const;
+      /// Delete propagator and return its size
+      virtual size_t dispose(Space* home);
+      /// Post propagator for \f$d=\|p-q\|\f$
+      static  ExecStatus post(Space* home, ViewArray<View>& p,
+                              ViewArray<View>& q, View d);
+    };
+
+    /*
+     * Piecewise linear function
+     *
+     */
+
+    /**
+     * \brief Piecewise linear function \f$y=f(x)\f$ given by breakpoints
+     *
+     * The breakpoints and a sparse table of range minima and maxima of
+     * their values (the envelope) are shared among all clones. Bounds are
+     * propagated in both directions with binary searches, so each
+     * propagation takes \f$O(\log n)\f$ time for \f$n\f$ breakpoints.
+     */
+    template <class View>
+    class Piecewise : public Propagator {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
+      /// The argument
+      View x;
+      /// The value
+      View y;
+      /// Abscissae of the breakpoints, strictly increasing
+      SharedArray<double> xs;
+      /// Ordinates of the breakpoints
+      SharedArray<double> ys;
+      /// Range minima of \a ys, one level of \a xs.size() per power of two
+      SharedArray<double> lo;
+      /// Range maxima of \a ys, laid out like \a lo
+      SharedArray<double> hi;
+      /// Return segment containing \a v
+      int segment(double v) const;
+      /// Return enclosure of \f$f(v)\f$ on segment \a k
+      Interval value(int k, double v) const;
+      /// Return minimum of \a ys between \a i and \a j (inclusive)
+      double rmin(int i, int j) const;
+      /// Return maximum of \a ys between \a i and \a j (inclusive)
+      double rmax(int i, int j) const;
+      /// Return enclosure of the point where segment \a k reaches \a c
+      Interval reach(int k, double c) const;
+      /// Constructor for cloning \a p
+      Piecewise(Space* home, bool share, Piecewise& p);
+      /// Constructor for posting
+      Piecewise(Space* home, View x, View y, SharedArray<double>& xs,
+                SharedArray<double>& ys, SharedArray<double>& lo,
+                SharedArray<double>& hi);
+    public:
+      /// Copy propagator during cloning
+      virtual Actor* copy(Space* home, bool share);
+      /// Perform propagation
+      virtual ExecStatus propagate(Space* home, ModEventDelta med);
+      /// Cost function
+      virtual PropCost cost(ModEventDelta med) const;
+      /// Delete propagator and return its size
+      virtual size_t dispose(Space* home);
+      /// Post propagator for \f$y=f(x)\f$ through (\a xs, \a ys)
+      static  ExecStatus post(Space* home, const FloatArgs& xs,
+                              const FloatArgs& ys, View x, View y);
+    };
+
+    /*
+     * Ordinary differential equations
+     *
+     */
+
+    /**
+     * \brief Validated flow of an autonomous ODE over a fixed time
+     *
+     * Links the initial state \f$x\f$ to the final state \f$y=\phi_t(x)\f$
+     * of \f$\dot{x}=f(x)\f$. Each integration step computes an a priori
+     * enclosure of the solution over the step by Picard iteration with
+     * inflation, and a second order Taylor expansion in mean value form
+     * whose Lagrange remainder is evaluated over that enclosure. Steps
+     * that cannot be validated are halved. The final state is narrowed by
+     * integrating forward, the initial state by integrating backward.
+     */
+    template <class View>
+    class Ode : public Propagator {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
+      /// Initial state, final state, then the parameters of the field
+      ViewArray<View> x;
+      /// Dimension of the state
+      int n;
+      /// Equations \f$\dot{x}_i=f_i\f$, the derivatives bound after the state
+      SharedArray<Equation> eqs;
+      /// Time horizon
+      double t;
+      /// Evaluate the field over \a b into \a f
+      void field(const Box& b, std::vector<Interval>& f) const;
+      /// Return derivative of field component \a i w.r.t. state \a j over \a b
+      Interval jacobian(int i, int j, const Box& b) const;
+      /// Advance the state in \a b by \a h, halving at most \a k times
+      bool step(Box& b, const Interval& h, int k) const;
+      /// Advance the state in \a b by \a t, false if not validated
+      bool flow(Box& b, double t) const;
+      /// Constructor for cloning \a p
+      Ode(Space* home, bool share, Ode& p);
+      /// Constructor for posting
+      Ode(Space* home, ViewArray<View>& x, int n,
+          SharedArray<Equation>& eqs, double t);
+    public:
+      /// Copy propagator during cloning
+      virtual Actor* copy(Space* home, bool share);
+      /// Perform propagation
+      virtual ExecStatus propagate(Space* home, ModEventDelta med);
+      /// Cost function
+      virtual PropCost cost(ModEventDelta med) const;
+      /// Delete propagator and return its size
+      virtual size_t dispose(Space* home);
+      /// Post propagator for \f$y=\phi_t(x)\f$ with field \a f over \a dx
+      static  ExecStatus post(Space* home, const FloatVarArgs& x,
+                              const FloatVarArgs& dx, const EquationArgs& f,
+                              const FloatVarArgs& y, double t);
+    };
+
+    /*
+     * Constructive disjunction
+     *
+     */
+
+    /**
+     * \brief Constructive disjunction over alternative sets of equations
+     *
+     * Each alternative is propagated by HC4 on a copy of the current box
+     * and the variables are narrowed to the hull of the boxes of the
+     * alternatives that do not fail. Alternatives that fail once are
+     * dropped for the node and all its descendants.
+     */
+    template <class View>
+    class Disjunction : public Propagator {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
+      /// The variables of all alternatives
+      ViewArray<View> x;
+      /// The equations of all alternatives, bound to the positions of \a x
+      SharedArray<Equation> eqs;
+      /// Alternative \a k consists of the equations alt[k] to alt[k+1]
+      SharedArray<int> alt;
+      /// Alternatives that have not failed yet
+      std::vector<int> live;
+      /// Constructor for cloning \a p
+      Disjunction(Space* home, bool share, Disjunction& p);
+      /// Constructor for posting
+      Disjunction(Space* home, ViewArray<View>& x, SharedArray<Equation>& eqs,
+                  SharedArray<int>& alt);
+    public:
+      /// Copy propagator during cloning
+      virtual Actor* copy(Space* home, bool share);
+      /// Perform propagation
+      virtual ExecStatus propagate(Space* home, ModEventDelta med);
+      /// Cost function
+      virtual PropCost cost(ModEventDelta med) const;
+      /// Delete propagator and return its size
+      virtual size_t dispose(Space* home);
+      /// Post propagator for alternatives of \a n[k] consecutive equations
+      static  ExecStatus post(Space* home, const EquationArgs& e,
+                              const IntArgs& n);
+    };
+
+  }
+}
+
+#include <gecode/float/global/newton.hpp>
+#include <gecode/float/global/linear.hpp>
+#include <gecode/float/global/shave.hpp>
+#include <gecode/float/global/mohc.hpp>
+#include <gecode/float/global/simplex.hpp>
+#include <gecode/float/global/polytope.hpp>
+#include <gecode/float/global/bernstein.hpp>
+#include <gecode/float/global/distance.hpp>
+#include <gecode/float/global/piecewise.hpp>
+#include <gecode/float/global/ode.hpp>
+#include <gecode/float/global/disjunction.hpp>
+#include <gecode/float/global/presolve.hpp>
+
+#endif
@@ -0,0 +1,273 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /// Largest number of Bernstein coefficients of a polynomial
+    const int bernstein_coefs = 4096;
+
+    /**
+     * \brief Restrict the Bernstein coefficients of one dimension
+     *
+     * The \a d+1 coefficients starting at \a c with stride \a s over
+     * \f$[0,1]\f$ are replaced by the coefficients over \f$[0,t]\f$ if
+     * \a left, or over \f$[t,1]\f$ otherwise (de Casteljau).
+     */
+    inline void
+    casteljau(boost::numeric::interval<double>* c, int d, int s,
+              const boost::numeric::interval<double>& t, bool left) {
+      typedef boost::numeric::interval<double> Interval;
+      std::vector<Interval> w(d+1), r(d+1);
+      for (int i = 0; i <= d; i++)
+        w[i] = c[i*s];
+      r[left ? 0 : d] = left ? w[0] : w[d];
+      for (int k = 1; k <= d; k++) {
+        for (int i = 0; i <= d-k; i++)
+          w[i] = (1.0 - t) * w[i] + t * w[i+1];
+        if (left)
+          r[k] = w[0];
+        else
+          r[d-k] = w[d-k];
+      }
+      for (int i = 0; i <= d; i++)
+        c[i*s] = r[i];
+    }
+
+    /**
+     * \brief Return zero crossings of the control points of one variable
+     *
+     * \a lo and \a hi are the smallest and largest coefficient for each
+     * index of the variable. Returns false if the convex hull of the
+     * control points does not meet zero, otherwise \a tl and \a th
+     * enclose the crossing in \f$[0,1]\f$. The crossings are computed
+     * with interval arithmetic, so the enclosure is rigorous.
+     */
+    inline bool
+    crossing(const std::vector<double>& lo, const std::vector<double>& hi,
+             double& tl, double& th) {
+      typedef boost::numeric::interval<double> Interval;
+      int d = static_cast<int>(lo.size()) - 1;
+      std::vector<Interval> pt;
+      std::vector<double> pv;
+      for (int i = 0; i <= d; i++) {
+        Interval t = Interval(static_cast<double>(i)) / static_cast<double>(d);
+        pt.push_back(t); pv.push_back(lo[i]);
+        pt.push_back(t); pv.push_back(hi[i]);
+      }
+      tl = 1.0; th = 0.0;
+      for (unsigned int p = 0; p < pt.size(); p++)
+        for (unsigned int q = p; q < pt.size(); q++) {
+          Interval a(pv[p]), b(pv[q]);
+          if (pv[p] == 0.0) {
+            tl = std::min(tl,lower(pt[p])); th = std::max(th,upper(pt[p]));
+          } else if (((pv[p] < 0.0) && (pv[q] > 0.0)) ||
+                     ((pv[p] > 0.0) && (pv[q] < 0.0))) {
+            Interval t = pt[p] + (pt[q] - pt[p]) * a / (a - b);
+            tl = std::min(tl,lower(t)); th = std::max(th,upper(t));
+          }
+        }
+      if (tl > th)
+        return false;
+      tl = std::max(0.0,tl);
+      th = std::min(1.0,th);
+      return true;
+    }
+
+    /*
+     * Bernstein propagator
+     *
+     */
+
+    template <class View>
+    forceinline
+    Bernstein<View>::Bernstein(Space* home, ViewArray<View>& x0,
+                               SharedArray<int>& deg0, const Box& pb0,
+                               const std::vector<Interval>& coef0)
+      : Propagator(home), x(x0), deg(deg0), pb(pb0), coef(coef0) {
+      x.subscribe(home,this,PC_FLOAT_BND);
+      home->notice(this,AP_DISPOSE);
+    }
+
+    template <class View>
+    forceinline
+    Bernstein<View>::Bernstein(Space* home, bool share, Bernstein& p)
+      : Propagator(home,share,p), pb(p.pb), coef(p.coef) {
+      x.update(home,share,p.x);
+      deg.update(home,share,p.deg);
+    }
+
+    template <class View>
+    Actor*
+    Bernstein<View>::copy(Space* home, bool share) {
+      return new (home) Bernstein(home,share,*this);
+    }
+
+    template <class View>
+    PropCost
+    Bernstein<View>::cost(ModEventDelta) const {
+      return PC_CRAZY_LO;
+    }
+
+    template <class View>
+    size_t
+    Bernstein<View>::dispose(Space* home) {
+      home->ignore(this,AP_DISPOSE);
+      x.cancel(home,this,PC_FLOAT_BND);
+      deg.~SharedArray();
+      pb.~Box();
+      coef.~vector();
+      (void) Propagator::dispose(home);
+      return sizeof(*this);
+    }
+
+    template <class View>
+    void
+    Bernstein<View>::restrict(void) {
+      int n = x.size();
+      int stride = 1;
+      for (int k = 0; k < n; k++) {
+        int d = deg[k];
+        double l = x[k].min(), u = x[k].max();
+        Interval w = Interval(upper(pb[k])) - lower(pb[k]);
+        if ((d > 0) && (width(pb[k]) > 0.0) &&
+            ((l > lower(pb[k])) || (u < upper(pb[k])))) {
+          for (int o = 0; o < static_cast<int>(coef.size()); o++) {
+            if ((o / stride) % (d+1) != 0)
+              continue;
+            // Restrict to [L,u], then to [l,u]
+            if (u < upper(pb[k]))
+              casteljau(&coef[o],d,stride,
+                        (Interval(u) - lower(pb[k])) / w,true);
+            if (l > lower(pb[k]))
+              casteljau(&coef[o],d,stride,
+                        (Interval(l) - lower(pb[k])) /
+                        (Interval(u) - lower(pb[k])),false);
+          }
+        }
+        pb[k] = Interval(l,u);
+        stride *= d+1;
+      }
+    }
+
+    template <class View>
+    ExecStatus
+    Bernstein<View>::propagate(Space* home, ModEventDelta) {
+      restrict();
+
+      // Range enclosure
+      double rl = upper(coef[0]), ru = lower(coef[0]);
+      for (int i = static_cast<int>(coef.size()); i--; ) {
+        rl = std::min(rl,lower(coef[i])); ru = std::max(ru,upper(coef[i]));
+      }
+      if ((rl > 0.0) || (ru < 0.0))
+        return ES_FAILED;
+
+      // Narrow each variable by the control points
+      int n = x.size();
+      int stride = 1;
+      for (int k = 0; k < n; k++) {
+        int d = deg[k];
+        if ((d > 0) && (width(pb[k]) > 0.0)) {
+          std::vector<double> lo(d+1,std::numeric_limits<double>::infinity());
+          std::vector<double> hi(d+1,-std::numeric_limits<double>::infinity());
+          for (int o = static_cast<int>(coef.size()); o--; ) {
+            int i = (o / stride) % (d+1);
+            lo[i] = std::min(lo[i],lower(coef[o]));
+            hi[i] = std::max(hi[i],upper(coef[o]));
+          }
+          double tl, th;
+          if (!crossing(lo,hi,tl,th))
+            return ES_FAILED;
+          Interval w = Interval(upper(pb[k])) - lower(pb[k]);
+          GECODE_ME_CHECK(x[k].gq(home,lower(lower(pb[k]) + w * tl)));
+          GECODE_ME_CHECK(x[k].lq(home,upper(lower(pb[k]) + w * th)));
+        }
+        stride *= d+1;
+      }
+
+      for (int i = n; i--; )
+        if (!x[i].assigned())
+          return ES_NOFIX;
+      return ES_SUBSUMED(this,home);
+    }
+
+    template <class View>
+    ExecStatus
+    Bernstein<View>::post(Space* home, Equation e) {
+      VarIndex vi;
+      Polynomial p;
+      if (!e.polynomial(vi,p))
+        throw NotPolynomial("Float::bernstein");
+      int n = vi.size();
+      SharedArray<int> deg(n);
+      std::vector<int> d(n);
+      double size = 1.0;
+      for (int k = n; k--; ) {
+        deg[k] = d[k] = p.degree(k);
+        size *= d[k]+1;
+      }
+      if (size > bernstein_coefs)
+        throw OutOfLimits("Float::bernstein");
+      Box pb(n);
+      for (int k = n; k--; )
+        pb[k] = Interval(vi[k]->min(),vi[k]->max());
+      std::vector<Interval> coef;
+      p.bernstein(pb,d,coef);
+      ViewArray<View> x(home,n);
+      for (int k = n; k--; )
+        x[k] = View(vi[k]);
+      (void) new (home) Bernstein(home,x,deg,pb,coef);
+      return ES_OK;
+    }
+
+  }
+
+  /*
+   * Constraints
+   *
+   */
+
+  forceinline void
+  bernstein(Space* home, Float::Equation eq) {
+    if (home->failed()) return;
+    if (Float::Bernstein<Float::FloatView>::post(home,eq) != ES_OK)
+      home->fail();
+  }
+
+}
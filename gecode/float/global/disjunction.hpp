@@ -0,0 +1,202 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /*
+     * Constructive disjunction
+     *
+     */
+
+    template <class View>
+    forceinline
+    Disjunction<View>::Disjunction(Space* home, ViewArray<View>& x0,
+                                   SharedArray<Equation>& eqs0,
+                                   SharedArray<int>& alt0)
+      : Propagator(home), x(x0), eqs(eqs0), alt(alt0) {
+      for (int k = 0; k < alt.size() - 1; k++)
+        live.push_back(k);
+      x.subscribe(home,this,PC_FLOAT_BND);
+      home->notice(this,AP_DISPOSE);
+    }
+
+    template <class View>
+    forceinline
+    Disjunction<View>::Disjunction(Space* home, bool share, Disjunction& p)
+      : Propagator(home,share,p), live(p.live) {
+      x.update(home,share,p.x);
+      eqs.update(home,share,p.eqs);
+      alt.update(home,share,p.alt);
+    }
+
+    template <class View>
+    Actor*
+    Disjunction<View>::copy(Space* home, bool share) {
+      return new (home) Disjunction(home,share,*this);
+    }
+
+    template <class View>
+    PropCost
+    Disjunction<View>::cost(ModEventDelta) const {
+      return PC_CRAZY_LO;
+    }
+
+    template <class View>
+    size_t
+    Disjunction<View>::dispose(Space* home) {
+      home->ignore(this,AP_DISPOSE);
+      x.cancel(home,this,PC_FLOAT_BND);
+      eqs.~SharedArray();
+      alt.~SharedArray();
+      live.~vector();
+      (void) Propagator::dispose(home);
+      return sizeof(*this);
+    }
+
+    template <class View>
+    ExecStatus
+    Disjunction<View>::propagate(Space* home, ModEventDelta) {
+      int n = x.size();
+      Box d(n);
+      double w = 0.0;
+      for (int i = n; i--; ) {
+        d[i] = Interval(x[i].min(),x[i].max());
+        w += width(d[i]);
+      }
+
+      // Hull of the boxes of the surviving alternatives
+      Box h(n);
+      int s = 0;
+      for (unsigned int k = 0; k < live.size(); k++) {
+        Box c(d);
+        if (!revise(eqs,alt[live[k]],alt[live[k]+1],c))
+          continue;
+        if (s == 0)
+          h = c;
+        else
+          for (int i = n; i--; )
+            h[i] = hull(h[i],c[i]);
+        live[s++] = live[k];
+      }
+      live.resize(s);
+      if (s == 0)
+        return ES_FAILED;
+
+      double v = 0.0;
+      for (int i = n; i--; ) {
+        GECODE_ME_CHECK(x[i].gq(home,lower(h[i])));
+        GECODE_ME_CHECK(x[i].lq(home,upper(h[i])));
+        v += width(h[i]);
+      }
+      for (int i = n; i--; )
+        if (!x[i].assigned())
+          return (v < revise_ratio * w) ? ES_NOFIX : ES_FIX;
+      return ES_SUBSUMED(this,home);
+    }
+
+    template <class View>
+    ExecStatus
+    Disjunction<View>::post(Space* home, const EquationArgs& e,
+                            const IntArgs& n) {
+      int m = 0;
+      for (int k = 0; k < n.size(); k++) {
+        if (n[k] < 0)
+          throw ArgumentSizeMismatch("Float::disjunction");
+        m += n[k];
+      }
+      if (m != e.size())
+        throw ArgumentSizeMismatch("Float::disjunction");
+      if (n.size() == 0)
+        return ES_FAILED;
+      // An empty alternative is always true
+      for (int k = n.size(); k--; )
+        if (n[k] == 0)
+          return ES_OK;
+
+      VarIndex vi;
+      SharedArray<Equation> eqs(m);
+      for (int i = m; i--; ) {
+        eqs[i] = e[i];
+        eqs[i].bind(vi);
+      }
+      SharedArray<int> alt(n.size()+1);
+      alt[0] = 0;
+      for (int k = 0; k < n.size(); k++)
+        alt[k+1] = alt[k] + n[k];
+      ViewArray<View> x(home,vi.size());
+      for (int i = vi.size(); i--; )
+        x[i] = View(vi[i]);
+      (void) new (home) Disjunction(home,x,eqs,alt);
+      return ES_OK;
+    }
+
+  }
+
+  /*
+   * Constraints
+   *
+   */
+
+  /**
+   * \brief Post the disjunction of alternatives of equations
+   *
+   * Alternative \f$k\f$ is the conjunction of the next \a n[k] equations
+   * of \a e.
+   */
+  forceinline void
+  disjunction(Space* home, const EquationArgs& e, const IntArgs& n) {
+    if (home->failed()) return;
+    if (Float::Disjunction<Float::FloatView>::post(home,e,n) != ES_OK)
+      home->fail();
+  }
+
+  /// Post the disjunction of the conjunctions \a e0 and \a e1
+  forceinline void
+  disjunction(Space* home, const EquationArgs& e0, const EquationArgs& e1) {
+    EquationArgs e(e0.size()+e1.size());
+    for (int i = e0.size(); i--; )
+      e[i] = e0[i];
+    for (int i = e1.size(); i--; )
+      e[e0.size()+i] = e1[i];
+    IntArgs n(2);
+    n[0] = e0.size(); n[1] = e1.size();
+    disjunction(home,e,n);
+  }
+
+}
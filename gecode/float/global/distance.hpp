@@ -0,0 +1,189 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /*
+     * Distance
+     *
+     */
+
+    template <class View>
+    forceinline
+    Distance<View>::Distance(Space* home, ViewArray<View>& p0,
+                             ViewArray<View>& q0, View d0)
+      : Propagator(home), p(p0), q(q0), d(d0) {
+      p.subscribe(home,this,PC_FLOAT_BND);
+      q.subscribe(home,this,PC_FLOAT_BND);
+      d.subscribe(home,this,PC_FLOAT_BND);
+    }
+
+    template <class View>
+    forceinline
+    Distance<View>::Distance(Space* home, bool share, Distance& pr)
+      : Propagator(home,share,pr) {
+      p.update(home,share,pr.p);
+      q.update(home,share,pr.q);
+      d.update(home,share,pr.d);
+    }
+
+    template <class View>
+    Actor*
+    Distance<View>::copy(Space* home, bool share) {
+      return new (home) Distance(home,share,*this);
+    }
+
+    template <class View>
+    PropCost
+    Distance<View>::cost(ModEventDelta) const {
+      return PC_LINEAR_LO;
+    }
+
+    template <class View>
+    size_t
+    Distance<View>::dispose(Space* home) {
+      p.cancel(home,this,PC_FLOAT_BND);
+      q.cancel(home,this,PC_FLOAT_BND);
+      d.cancel(home,this,PC_FLOAT_BND);
+      (void) Propagator::dispose(home);
+      return sizeof(*this);
+    }
+
+    template <class View>
+    ExecStatus
+    Distance<View>::propagate(Space* home, ModEventDelta) {
+      const double inf = std::numeric_limits<double>::infinity();
+      int n = p.size();
+      Box b(2*n+1);
+      for (int i = n; i--; ) {
+        b[i] = Interval(p[i].min(),p[i].max());
+        b[n+i] = Interval(q[i].min(),q[i].max());
+      }
+      b[2*n] = Interval(d.min(),d.max());
+      double w = 0.0;
+      for (int i = 2*n+1; i--; )
+        w += width(b[i]);
+
+      // Distance between the nearest and farthest points of the boxes
+      std::vector<Interval> dx(n);
+      Interval s(0.0);
+      for (int i = n; i--; ) {
+        dx[i] = b[i] - b[n+i];
+        s += square(dx[i]);
+      }
+      if (!narrow(b[2*n],Interval(0.0,inf)) || !narrow(b[2*n],sqrt(s)))
+        return ES_FAILED;
+
+      // Ball and annulus projections of each difference
+      Interval d2 = square(b[2*n]);
+      for (int i = 0; i < n; i++) {
+        Interval r(0.0);
+        for (int j = n; j--; )
+          if (j != i)
+            r += square(dx[j]);
+        Interval t = d2 - r;
+        if (!narrow(t,Interval(0.0,inf)))
+          return ES_FAILED;
+        Interval e = sqrt(t);
+        if (!narrow(dx[i],Interval(-upper(e),upper(e))))
+          return ES_FAILED;
+        if (lower(e) > 0.0) {
+          // Remove (-min e, min e) and keep the hull
+          bool neg = lower(dx[i]) <= -lower(e);
+          bool pos = upper(dx[i]) >= lower(e);
+          if (!neg && !pos)
+            return ES_FAILED;
+          if (!neg)
+            dx[i] = Interval(std::max(lower(dx[i]),lower(e)),upper(dx[i]));
+          else if (!pos)
+            dx[i] = Interval(lower(dx[i]),std::min(upper(dx[i]),-lower(e)));
+        }
+        if (!narrow(b[i],b[n+i] + dx[i]) || !narrow(b[n+i],b[i] - dx[i]))
+          return ES_FAILED;
+        dx[i] = b[i] - b[n+i];
+      }
+
+      double v = 0.0;
+      for (int i = n; i--; ) {
+        GECODE_ME_CHECK(p[i].gq(home,lower(b[i])));
+        GECODE_ME_CHECK(p[i].lq(home,upper(b[i])));
+        GECODE_ME_CHECK(q[i].gq(home,lower(b[n+i])));
+        GECODE_ME_CHECK(q[i].lq(home,upper(b[n+i])));
+        v += width(b[i]) + width(b[n+i]);
+      }
+      GECODE_ME_CHECK(d.gq(home,lower(b[2*n])));
+      GECODE_ME_CHECK(d.lq(home,upper(b[2*n])));
+      v += width(b[2*n]);
+
+      if (!d.assigned())
+        return (v < revise_ratio * w) ? ES_NOFIX : ES_FIX;
+      for (int i = n; i--; )
+        if (!p[i].assigned() || !q[i].assigned())
+          return (v < revise_ratio * w) ? ES_NOFIX : ES_FIX;
+      return ES_SUBSUMED(this,home);
+    }
+
+    template <class View>
+    ExecStatus
+    Distance<View>::post(Space* home, ViewArray<View>& p, ViewArray<View>& q,
+                         View d) {
+      GECODE_ME_CHECK(d.gq(home,0.0));
+      (void) new (home) Distance(home,p,q,d);
+      return ES_OK;
+    }
+
+  }
+
+  /*
+   * Constraints
+   *
+   */
+
+  forceinline void
+  distance(Space* home, const FloatVarArgs& p, const FloatVarArgs& q,
+           FloatVar d) {
+    if (p.size() != q.size())
+      throw Float::ArgumentSizeMismatch("Float::distance");
+    if (home->failed()) return;
+    ViewArray<Float::FloatView> vp(home,p), vq(home,q);
+    if (Float::Distance<Float::FloatView>::post(home,vp,vq,d) != ES_OK)
+      home->fail();
+  }
+
+}
@@ -0,0 +1,305 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /// Rows of the diagonal blocks inverted for preconditioning
+    const int linear_precondition_limit = 64;
+    /// A sweep is repeated while it reduces the width below this ratio
+    const double linear_ratio = 0.9;
+
+    /*
+     * Linear systems
+     *
+     */
+
+    template <class View>
+    forceinline
+    LinearSystem<View>::LinearSystem(Space* home, ViewArray<View>& x0,
+                                     SharedArray<int>& row0,
+                                     SharedArray<int>& col0,
+                                     SharedArray<Interval>& a0,
+                                     SharedArray<Interval>& b0)
+      : Propagator(home), x(x0), row(row0), col(col0), a(a0), b(b0) {
+      x.subscribe(home,this,PC_FLOAT_BND);
+      home->notice(this,AP_DISPOSE);
+    }
+
+    template <class View>
+    forceinline
+    LinearSystem<View>::LinearSystem(Space* home, bool share, LinearSystem& p)
+      : Propagator(home,share,p) {
+      x.update(home,share,p.x);
+      row.update(home,share,p.row);
+      col.update(home,share,p.col);
+      a.update(home,share,p.a);
+      b.update(home,share,p.b);
+    }
+
+    template <class View>
+    Actor*
+    LinearSystem<View>::copy(Space* home, bool share) {
+      return new (home) LinearSystem(home,share,*this);
+    }
+
+    template <class View>
+    PropCost
+    LinearSystem<View>::cost(ModEventDelta) const {
+      return PC_LINEAR_HI;
+    }
+
+    template <class View>
+    size_t
+    LinearSystem<View>::dispose(Space* home) {
+      home->ignore(this,AP_DISPOSE);
+      x.cancel(home,this,PC_FLOAT_BND);
+      row.~SharedArray();
+      col.~SharedArray();
+      a.~SharedArray();
+      b.~SharedArray();
+      (void) Propagator::dispose(home);
+      return sizeof(*this);
+    }
+
+    template <class View>
+    ExecStatus
+    LinearSystem<View>::propagate(Space* home, ModEventDelta) {
+      Box d(x.size());
+      double w = 0.0;
+      for (int i = x.size(); i--; ) {
+        d[i] = Interval(x[i].min(),x[i].max());
+        w += width(d[i]);
+      }
+
+      // Prefix sums of the terms of a row, suffix sums are accumulated backwards
+      std::vector<Interval> s;
+      for (int r = 0; r < b.size(); r++) {
+        int f = row[r], l = row[r+1];
+        s.resize(l-f+1);
+        s[0] = Interval(0.0);
+        for (int k = f; k < l; k++)
+          s[k-f+1] = s[k-f] + a[k] * d[col[k]];
+        Interval t(0.0);
+        for (int k = l; k-- > f; ) {
+          int j = col[k];
+          if (!zero_in(a[k])) {
+            Interval p = (b[r] - s[k-f] - t) / a[k];
+            double lo = std::max(lower(p),lower(d[j]));
+            double hi = std::min(upper(p),upper(d[j]));
+            if (lo > hi)
+              return ES_FAILED;
+            d[j] = Interval(lo,hi);
+          }
+          t += a[k] * d[j];
+        }
+      }
+
+      double v = 0.0;
+      for (int i = x.size(); i--; ) {
+        GECODE_ME_CHECK(x[i].gq(home,lower(d[i])));
+        GECODE_ME_CHECK(x[i].lq(home,upper(d[i])));
+        v += width(d[i]);
+      }
+
+      for (int i = x.size(); i--; )
+        if (!x[i].assigned())
+          return (v < linear_ratio * w) ? ES_NOFIX : ES_FIX;
+      return ES_SUBSUMED(this,home);
+    }
+
+    template <class View>
+    ExecStatus
+    LinearSystem<View>::post(Space* home, const FloatArgs& a0,
+                             const FloatVarArgs& y, const FloatArgs& b0) {
+      int m = b0.size(), n = y.size();
+      if (a0.size() != m*n)
+        throw ArgumentSizeMismatch("Float::linear_system");
+      int nnz = 0;
+      for (int k = m*n; k--; )
+        if (a0[k] != 0.0)
+          nnz++;
+      IntArgs r(nnz), c(nnz);
+      FloatArgs v(nnz);
+      for (int k = 0, t = 0; k < m*n; k++)
+        if (a0[k] != 0.0) {
+          r[t] = k / n; c[t] = k % n; v[t] = a0[k]; t++;
+        }
+      return post(home,r,c,v,y,b0);
+    }
+
+    template <class View>
+    ExecStatus
+    LinearSystem<View>::post(Space* home, const IntArgs& r0,
+                             const IntArgs& c0, const FloatArgs& v0,
+                             const FloatVarArgs& y, const FloatArgs& b0) {
+      int m = b0.size(), n = y.size(), t = v0.size();
+      if ((r0.size() != t) || (c0.size() != t))
+        throw ArgumentSizeMismatch("Float::linear_system");
+      for (int k = t; k--; )
+        if ((r0[k] < 0) || (r0[k] >= m) || (c0[k] < 0) || (c0[k] >= n))
+          throw OutOfLimits("Float::linear_system");
+
+      // CSR of the triplets, with each row sorted and duplicates summed
+      std::vector<int> rp(m+1,0);
+      for (int k = t; k--; )
+        rp[r0[k]+1]++;
+      for (int i = 0; i < m; i++)
+        rp[i+1] += rp[i];
+      std::vector<std::pair<int,double> > e(t);
+      {
+        std::vector<int> f(rp.begin(),rp.end()-1);
+        for (int k = 0; k < t; k++)
+          e[f[r0[k]]++] = std::make_pair(c0[k],v0[k]);
+      }
+      std::vector<int> ci;
+      std::vector<Interval> av;
+      std::vector<int> ap(m+1,0);
+      for (int i = 0; i < m; i++) {
+        std::sort(e.begin()+rp[i],e.begin()+rp[i+1]);
+        for (int k = rp[i]; k < rp[i+1]; k++)
+          if ((k > rp[i]) && (e[k].first == e[k-1].first)) {
+            av.back() += Interval(e[k].second);
+          } else {
+            ci.push_back(e[k].first); av.push_back(Interval(e[k].second));
+          }
+        ap[i+1] = ci.size();
+      }
+
+      // Block Jacobi preconditioning of square systems
+      std::vector<int> pr(1,0), pc;
+      std::vector<Interval> pa, pb(m);
+      std::vector<Interval> acc(n);
+      std::vector<bool> used(n,false);
+      std::vector<int> cols;
+      for (int s = 0; s < m; s += linear_precondition_limit) {
+        int l = std::min(m,s+linear_precondition_limit), q = l-s;
+        std::vector<double> p(q*q);
+        bool pre = false;
+        if (m == n) {
+          std::vector<double> md(q*q,0.0);
+          for (int i = s; i < l; i++)
+            for (int k = ap[i]; k < ap[i+1]; k++)
+              if ((ci[k] >= s) && (ci[k] < l))
+                md[(i-s)*q+ci[k]-s] = median(av[k]);
+          pre = midinverse(q,md,p);
+        }
+        for (int i = s; i < l; i++) {
+          if (pre) {
+            pb[i] = Interval(0.0);
+            for (int h = 0; h < q; h++) {
+              if (p[(i-s)*q+h] == 0.0)
+                continue;
+              Interval g(p[(i-s)*q+h]);
+              pb[i] += g * b0[s+h];
+              for (int k = ap[s+h]; k < ap[s+h+1]; k++) {
+                if (!used[ci[k]]) {
+                  used[ci[k]] = true; acc[ci[k]] = Interval(0.0);
+                  cols.push_back(ci[k]);
+                }
+                acc[ci[k]] += g * av[k];
+              }
+            }
+          } else {
+            pb[i] = Interval(b0[i]);
+            for (int k = ap[i]; k < ap[i+1]; k++) {
+              used[ci[k]] = true; acc[ci[k]] = av[k];
+              cols.push_back(ci[k]);
+            }
+          }
+          std::sort(cols.begin(),cols.end());
+          for (unsigned int k = 0; k < cols.size(); k++) {
+            int j = cols[k];
+            if ((lower(acc[j]) != 0.0) || (upper(acc[j]) != 0.0)) {
+              pc.push_back(j); pa.push_back(acc[j]);
+            }
+            used[j] = false;
+          }
+          cols.clear();
+          pr.push_back(pc.size());
+        }
+      }
+
+      SharedArray<int> row(m+1), col(pc.size());
+      SharedArray<Interval> a(pa.size()), b(m);
+      for (int i = m+1; i--; )
+        row[i] = pr[i];
+      for (int k = pc.size(); k--; ) {
+        col[k] = pc[k]; a[k] = pa[k];
+      }
+      for (int i = m; i--; )
+        b[i] = pb[i];
+
+      ViewArray<View> x(home,y);
+      (void) new (home) LinearSystem(home,x,row,col,a,b);
+      return ES_OK;
+    }
+
+  }
+
+  /*
+   * Constraints
+   *
+   */
+
+  forceinline void
+  linear_system(Space* home, const FloatArgs& a, const FloatVarArgs& x,
+                const FloatArgs& b) {
+    if (home->failed()) return;
+    if (Float::LinearSystem<Float::FloatView>::post(home,a,x,b) != ES_OK)
+      home->fail();
+  }
+
+  /**
+   * \brief Post propagator for \f$Ax=b\f$ with sparse \f$A\f$
+   *
+   * \f$A\f$ is given by the triplets \a r, \a c and \a v, entry \f$k\f$
+   * adding \a v[k] to \f$A_{r[k],c[k]}\f$. Memory is linear in the number
+   * of triplets and variables, plus the fill of the preconditioning
+   * within the rows of each diagonal block.
+   */
+  forceinline void
+  linear_system(Space* home, const IntArgs& r, const IntArgs& c,
+                const FloatArgs& v, const FloatVarArgs& x,
+                const FloatArgs& b) {
+    if (home->failed()) return;
+    if (Float::LinearSystem<Float::FloatView>::post(home,r,c,v,x,b) != ES_OK)
+      home->fail();
+  }
+
+}
@@ -0,0 +1,215 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /// Maximal number of dichotomy steps of MonotonicBoxNarrow per bound
+    const int mohc_steps = 20;
+    /// Dichotomy stops at slices below this fraction of the domain width
+    const double mohc_ratio = 0.01;
+
+    /*
+     * Monotonicity-based contractor
+     *
+     */
+
+    template <class View>
+    forceinline
+    Mohc<View>::Mohc(Space* home, ViewArray<View>& x0,
+                     SharedArray<Equation>& eq0)
+      : Propagator(home), x(x0), eq(eq0) {
+      x.subscribe(home,this,PC_FLOAT_BND);
+      home->notice(this,AP_DISPOSE);
+    }
+
+    template <class View>
+    forceinline
+    Mohc<View>::Mohc(Space* home, bool share, Mohc& p)
+      : Propagator(home,share,p) {
+      x.update(home,share,p.x);
+      eq.update(home,share,p.eq);
+    }
+
+    template <class View>
+    Actor*
+    Mohc<View>::copy(Space* home, bool share) {
+      return new (home) Mohc(home,share,*this);
+    }
+
+    template <class View>
+    PropCost
+    Mohc<View>::cost(ModEventDelta) const {
+      return PC_QUADRATIC_HI;
+    }
+
+    template <class View>
+    size_t
+    Mohc<View>::dispose(Space* home) {
+      home->ignore(this,AP_DISPOSE);
+      x.cancel(home,this,PC_FLOAT_BND);
+      eq.~SharedArray();
+      (void) Propagator::dispose(home);
+      return sizeof(*this);
+    }
+
+    template <class View>
+    bool
+    Mohc<View>::narrow(Box& b) const {
+      const Equation& e = eq[0];
+      int n = b.size();
+
+      // Corner boxes where the monotone variables minimize or maximize f
+      Box bmin(b), bmax(b);
+      std::vector<int> dir(n,0);
+      bool any = false;
+      for (int i = n; i--; ) {
+        Interval g = e.derivative(i,b);
+        if (lower(g) >= 0.0) {
+          bmin[i] = Interval(lower(b[i])); bmax[i] = Interval(upper(b[i]));
+          dir[i] = 1;
+        } else if (upper(g) <= 0.0) {
+          bmin[i] = Interval(upper(b[i])); bmax[i] = Interval(lower(b[i]));
+          dir[i] = -1;
+        } else {
+          continue;
+        }
+        any = true;
+      }
+      if (!any)
+        return true;
+
+      // MinMax test
+      if ((lower(e.residual(bmin)) > 0.0) || (upper(e.residual(bmax)) < 0.0))
+        return false;
+
+      // MonotonicBoxNarrow: a slice of a monotone variable is refuted if
+      // f cannot reach zero at any corner it is combined with
+      for (int i = n; i--; ) {
+        if ((dir[i] == 0) || (width(b[i]) == 0.0))
+          continue;
+        double eps = mohc_ratio * width(b[i]);
+        Box smin(bmin), smax(bmax);
+        // Narrow the lower bound
+        double l = lower(b[i]), h = upper(b[i]);
+        for (int k = 0; (k < mohc_steps) && (h - l > eps); k++) {
+          double m = l + (h - l) / 2.0;
+          smin[i] = smax[i] = Interval(l,m);
+          if ((lower(e.residual(smin)) > 0.0) ||
+              (upper(e.residual(smax)) < 0.0))
+            l = m;
+          else
+            h = m;
+        }
+        double nl = l;
+        // Narrow the upper bound
+        l = nl; h = upper(b[i]);
+        for (int k = 0; (k < mohc_steps) && (h - l > eps); k++) {
+          double m = l + (h - l) / 2.0;
+          smin[i] = smax[i] = Interval(m,h);
+          if ((lower(e.residual(smin)) > 0.0) ||
+              (upper(e.residual(smax)) < 0.0))
+            h = m;
+          else
+            l = m;
+        }
+        if (!Float::narrow(b[i],Interval(nl,h)))
+          return false;
+        // Keep the corners used for the other variables inside b
+        if (dir[i] > 0) {
+          bmin[i] = Interval(lower(b[i])); bmax[i] = Interval(upper(b[i]));
+        } else {
+          bmin[i] = Interval(upper(b[i])); bmax[i] = Interval(lower(b[i]));
+        }
+      }
+      return true;
+    }
+
+    template <class View>
+    ExecStatus
+    Mohc<View>::propagate(Space* home, ModEventDelta) {
+      Box b(x.size());
+      double w = 0.0;
+      for (int i = x.size(); i--; ) {
+        b[i] = Interval(x[i].min(),x[i].max());
+        w += width(b[i]);
+      }
+      if (!revise(eq,b) || !narrow(b))
+        return ES_FAILED;
+
+      double v = 0.0;
+      for (int i = x.size(); i--; ) {
+        GECODE_ME_CHECK(x[i].gq(home,lower(b[i])));
+        GECODE_ME_CHECK(x[i].lq(home,upper(b[i])));
+        v += width(b[i]);
+      }
+      for (int i = x.size(); i--; )
+        if (!x[i].assigned())
+          return (v < revise_ratio * w) ? ES_NOFIX : ES_FIX;
+      return ES_SUBSUMED(this,home);
+    }
+
+    template <class View>
+    ExecStatus
+    Mohc<View>::post(Space* home, Equation e) {
+      VarIndex vi;
+      SharedArray<Equation> eq(1);
+      eq[0] = e.rewrite();
+      eq[0].bind(vi);
+      ViewArray<View> x(home,vi.size());
+      for (int i = vi.size(); i--; )
+        x[i] = View(vi[i]);
+      (void) new (home) Mohc(home,x,eq);
+      return ES_OK;
+    }
+
+  }
+
+  /*
+   * Constraints
+   *
+   */
+
+  forceinline void
+  mohc(Space* home, Float::Equation eq) {
+    if (home->failed()) return;
+    if (Float::Mohc<Float::FloatView>::post(home,eq) != ES_OK)
+      home->fail();
+  }
+
+}
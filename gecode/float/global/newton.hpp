@@ -0,0 +1,311 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /// Maximal number of Newton steps per propagation
+    const int newton_iterations = 16;
+    /// Newton steps stop when the box keeps more than this ratio of its width
+    const double newton_ratio = 0.9;
+
+    /*
+     * Dense linear algebra for the Newton contractor
+     *
+     */
+
+    /**
+     * \brief Invert the \a n by \a n matrix \a m (row-major) into \a y
+     *
+     * Uses Gauss-Jordan elimination with partial pivoting. Returns false
+     * if \a m is singular, in which case \a y is left undefined.
+     */
+    inline bool
+    midinverse(int n, std::vector<double> m, std::vector<double>& y) {
+      for (int r = n; r--; )
+        for (int s = n; s--; )
+          y[r*n+s] = (r == s) ? 1.0 : 0.0;
+      for (int k = 0; k < n; k++) {
+        int p = k;
+        for (int r = k+1; r < n; r++)
+          if (fabs(m[r*n+k]) > fabs(m[p*n+k]))
+            p = r;
+        if (m[p*n+k] == 0.0)
+          return false;
+        if (p != k)
+          for (int s = n; s--; ) {
+            std::swap(m[p*n+s],m[k*n+s]);
+            std::swap(y[p*n+s],y[k*n+s]);
+          }
+        double d = m[k*n+k];
+        for (int s = n; s--; ) {
+          m[k*n+s] /= d; y[k*n+s] /= d;
+        }
+        for (int r = n; r--; )
+          if ((r != k) && (m[r*n+k] != 0.0)) {
+            double f = m[r*n+k];
+            for (int s = n; s--; ) {
+              m[r*n+s] -= f*m[k*n+s]; y[r*n+s] -= f*y[k*n+s];
+            }
+          }
+      }
+      return true;
+    }
+
+    /**
+     * \brief Perform one Hansen-Sengupta step on the entries \a v of \a b
+     *
+     * Equation \a r of \a eqs, for \f$r<|v|\f$, is solved for entry
+     * \a v[r], the other entries of \a b are parameters. The system is
+     * linearized around the midpoint of the box and preconditioned with
+     * the inverse of the midpoint Jacobian. Returns false if the box is
+     * proven to contain no root. Sets \a unique if the step maps the box
+     * into its interior. A box with an unbounded entry in \a v has no
+     * midpoint and is left unchanged.
+     */
+    template <class Eqs>
+    inline bool
+    hansen_sengupta(const Eqs& eqs, const std::vector<int>& v, Box& b,
+                    bool& unique) {
+      typedef boost::numeric::interval<double> Interval;
+      int n = static_cast<int>(v.size());
+      for (int i = n; i--; )
+        if ((lower(b[v[i]]) <= -std::numeric_limits<double>::max()) ||
+            (upper(b[v[i]]) >= std::numeric_limits<double>::max()))
+          return true;
+      std::vector<double> c(n);
+      Box bc(b);
+      for (int i = n; i--; ) {
+        c[i] = median(b[v[i]]);
+        bc[v[i]] = Interval(c[i]);
+      }
+
+      // Residual at the midpoint and Jacobian over the box
+      std::vector<Interval> f(n), j(n*n);
+      std::vector<double> m(n*n), y(n*n);
+      for (int r = n; r--; ) {
+        f[r] = eqs[r].residual(bc);
+        for (int s = n; s--; ) {
+          j[r*n+s] = eqs[r].derivative(v[s],b);
+          m[r*n+s] = median(j[r*n+s]);
+        }
+      }
+      if (!midinverse(n,m,y))
+        for (int r = n; r--; )
+          for (int s = n; s--; )
+            y[r*n+s] = (r == s) ? 1.0 : 0.0;
+
+      // Preconditioned system
+      std::vector<Interval> a(n*n), g(n);
+      for (int r = n; r--; ) {
+        g[r] = Interval(0.0);
+        for (int k = n; k--; )
+          g[r] += y[r*n+k] * f[k];
+        for (int s = n; s--; ) {
+          a[r*n+s] = Interval(0.0);
+          for (int k = n; k--; )
+            a[r*n+s] += y[r*n+k] * j[k*n+s];
+        }
+      }
+
+      // Gauss-Seidel sweep
+      bool inner = true;
+      for (int i = 0; i < n; i++) {
+        if (zero_in(a[i*n+i])) {
+          inner = false; continue;
+        }
+        Interval s = g[i];
+        for (int k = n; k--; )
+          if (k != i)
+            s += a[i*n+k] * (b[v[k]] - c[k]);
+        Interval ni = c[i] - s / a[i*n+i];
+        if (!((lower(ni) > lower(b[v[i]])) && (upper(ni) < upper(b[v[i]]))))
+          inner = false;
+        double l = std::max(lower(ni),lower(b[v[i]]));
+        double h = std::min(upper(ni),upper(b[v[i]]));
+        if (l > h)
+          return false;
+        b[v[i]] = Interval(l,h);
+      }
+      unique = unique || inner;
+      return true;
+    }
+
+    /**
+     * \brief Perform one Hansen-Sengupta step on the first \a n entries of \a b
+     *
+     * Returns false if the box is proven to contain no root. Sets \a
+     * unique if the step maps the box into its interior.
+     */
+    inline bool
+    hansen_sengupta(int n, const SharedArray<Equation>& eqs, Box& b,
+                    bool& unique) {
+      std::vector<int> v(n);
+      for (int i = n; i--; )
+        v[i] = i;
+      return hansen_sengupta(eqs,v,b,unique);
+    }
+
+    /*
+     * Interval Newton contractor
+     *
+     */
+
+    template <class View>
+    forceinline
+    Newton<View>::Newton(Space* home, ViewArray<View>& x0, int n0,
+                         SharedArray<Equation>& eqs0, Int::BoolView u0)
+      : Propagator(home), x(x0), n(n0), eqs(eqs0), u(u0) {
+      x.subscribe(home,this,PC_FLOAT_BND);
+      home->notice(this,AP_DISPOSE);
+    }
+
+    template <class View>
+    forceinline
+    Newton<View>::Newton(Space* home, bool share, Newton& p)
+      : Propagator(home,share,p), n(p.n) {
+      x.update(home,share,p.x);
+      eqs.update(home,share,p.eqs);
+      u.update(home,share,p.u);
+    }
+
+    template <class View>
+    Actor*
+    Newton<View>::copy(Space* home, bool share) {
+      return new (home) Newton(home,share,*this);
+    }
+
+    template <class View>
+    PropCost
+    Newton<View>::cost(ModEventDelta) const {
+      return PC_CUBIC_HI;
+    }
+
+    template <class View>
+    size_t
+    Newton<View>::dispose(Space* home) {
+      home->ignore(this,AP_DISPOSE);
+      x.cancel(home,this,PC_FLOAT_BND);
+      eqs.~SharedArray();
+      (void) Propagator::dispose(home);
+      return sizeof(*this);
+    }
+
+    template <class View>
+    ExecStatus
+    Newton<View>::propagate(Space* home, ModEventDelta) {
+      Box b(x.size());
+      for (int i = x.size(); i--; )
+        b[i] = Interval(x[i].min(),x[i].max());
+
+      Box o(b);
+      bool unique = false;
+      for (int k = 0; k < newton_iterations; k++) {
+        double w = 0.0;
+        for (int i = n; i--; )
+          w += width(b[i]);
+        if (!hansen_sengupta(n,eqs,b,unique))
+          return ES_FAILED;
+        double v = 0.0;
+        for (int i = n; i--; )
+          v += width(b[i]);
+        if (v > newton_ratio * w)
+          break;
+      }
+
+      bool moved = false;
+      for (int i = n; i--; ) {
+        GECODE_ME_CHECK(x[i].gq(home,lower(b[i])));
+        GECODE_ME_CHECK(x[i].lq(home,upper(b[i])));
+        if ((lower(b[i]) != lower(o[i])) || (upper(b[i]) != upper(o[i])))
+          moved = true;
+      }
+      if (unique)
+        GECODE_ME_CHECK(u.one(home));
+
+      for (int i = x.size(); i--; )
+        if (!x[i].assigned())
+          return moved ? ES_NOFIX : ES_FIX;
+      return ES_SUBSUMED(this,home);
+    }
+
+    template <class View>
+    ExecStatus
+    Newton<View>::post(Space* home, const EquationArgs& e,
+                       const FloatVarArgs& y, Int::BoolView u) {
+      if (e.size() != y.size())
+        throw ArgumentSizeMismatch("Float::newton");
+      VarIndex vi;
+      for (int i = 0; i < y.size(); i++)
+        (void) vi.index(y[i].var());
+      if (vi.size() != y.size())
+        throw ArgumentSame("Float::newton");
+
+      SharedArray<Equation> eqs(e.size());
+      for (int i = e.size(); i--; ) {
+        eqs[i] = e[i];
+        eqs[i].bind(vi);
+      }
+      ViewArray<View> x(home,vi.size());
+      for (int i = vi.size(); i--; )
+        x[i] = View(vi[i]);
+      (void) new (home) Newton(home,x,y.size(),eqs,u);
+      return ES_OK;
+    }
+
+  }
+
+  /*
+   * Constraints
+   *
+   */
+
+  forceinline void
+  newton(Space* home, const EquationArgs& eqs, const FloatVarArgs& x,
+         BoolVar u) {
+    if (home->failed()) return;
+    if (Float::Newton<Float::FloatView>::post(home,eqs,x,u) != ES_OK)
+      home->fail();
+  }
+
+  forceinline void
+  newton(Space* home, const EquationArgs& eqs, const FloatVarArgs& x) {
+    newton(home,eqs,x,BoolVar(home,0,1));
+  }
+
+}
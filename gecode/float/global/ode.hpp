@@ -0,0 +1,301 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /// Number of integration steps over the time horizon
+    const int ode_steps = 16;
+    /// Largest number of times an integration step is halved
+    const int ode_halvings = 8;
+    /// Number of inflation rounds for an a priori enclosure
+    const int ode_apriori = 8;
+    /// Relative inflation of a candidate a priori enclosure
+    const double ode_inflate = 0.1;
+
+    /*
+     * ODE propagator
+     *
+     */
+
+    template <class View>
+    forceinline
+    Ode<View>::Ode(Space* home, ViewArray<View>& x0, int n0,
+                   SharedArray<Equation>& eqs0, double t0)
+      : Propagator(home), x(x0), n(n0), eqs(eqs0), t(t0) {
+      x.subscribe(home,this,PC_FLOAT_BND);
+      home->notice(this,AP_DISPOSE);
+    }
+
+    template <class View>
+    forceinline
+    Ode<View>::Ode(Space* home, bool share, Ode& p)
+      : Propagator(home,share,p), n(p.n), t(p.t) {
+      x.update(home,share,p.x);
+      eqs.update(home,share,p.eqs);
+    }
+
+    template <class View>
+    Actor*
+    Ode<View>::copy(Space* home, bool share) {
+      return new (home) Ode(home,share,*this);
+    }
+
+    template <class View>
+    PropCost
+    Ode<View>::cost(ModEventDelta) const {
+      return PC_CRAZY_HI;
+    }
+
+    template <class View>
+    size_t
+    Ode<View>::dispose(Space* home) {
+      home->ignore(this,AP_DISPOSE);
+      x.cancel(home,this,PC_FLOAT_BND);
+      eqs.~SharedArray();
+      (void) Propagator::dispose(home);
+      return sizeof(*this);
+    }
+
+    template <class View>
+    forceinline void
+    Ode<View>::field(const Box& b, std::vector<Interval>& f) const {
+      // The derivatives are zero in b, so the residual is -f
+      for (int i = n; i--; )
+        f[i] = -eqs[i].residual(b);
+    }
+
+    template <class View>
+    forceinline boost::numeric::interval<double>
+    Ode<View>::jacobian(int i, int j, const Box& b) const {
+      return -eqs[i].derivative(j,b);
+    }
+
+    template <class View>
+    bool
+    Ode<View>::step(Box& s, const Interval& h, int k) const {
+      std::vector<Interval> f(n), g(n);
+
+      // A priori enclosure over the step: s + [0,h] f(b) within b
+      Interval th = hull(Interval(0.0),h);
+      Box b(s);
+      field(s,f);
+      for (int i = n; i--; )
+        b[i] = s[i] + th * f[i];
+      bool valid = false;
+      for (int r = 0; !valid && (r < ode_apriori); r++) {
+        for (int i = n; i--; ) {
+          double e = ode_inflate * width(b[i]) +
+            std::numeric_limits<double>::min();
+          b[i] = Interval(lower(b[i]) - e,upper(b[i]) + e);
+        }
+        field(b,f);
+        valid = true;
+        for (int i = n; i--; ) {
+          g[i] = s[i] + th * f[i];
+          if (!subset(g[i],b[i]))
+            valid = false;
+        }
+        if (valid)
+          for (int i = n; i--; )
+            b[i] = g[i];
+      }
+      if (!valid)
+        return (k > 0) &&
+          step(s,h / 2.0,k-1) && step(s,h / 2.0,k-1);
+
+      // Remainder: x'' = J(x) f(x) over the a priori enclosure
+      field(b,f);
+      std::vector<Interval> rem(n,Interval(0.0));
+      for (int i = n; i--; )
+        for (int j = n; j--; )
+          rem[i] += jacobian(i,j,b) * f[j];
+
+      // x + h f(x) in mean value form, intersected with the natural form
+      Box m(s);
+      for (int i = n; i--; )
+        m[i] = Interval(median(s[i]));
+      field(m,f);
+      field(s,g);
+      std::vector<Interval> y(n);
+      for (int i = n; i--; ) {
+        y[i] = m[i] + h * f[i];
+        for (int j = n; j--; )
+          y[i] += ((i == j) ? (1.0 + h * jacobian(i,j,s))
+                            : h * jacobian(i,j,s)) * (s[j] - m[j]);
+        (void) narrow(y[i],s[i] + h * g[i]);
+      }
+      for (int i = n; i--; )
+        s[i] = y[i] + square(h) / 2.0 * rem[i];
+      return true;
+    }
+
+    template <class View>
+    bool
+    Ode<View>::flow(Box& b, double t) const {
+      const double inf = std::numeric_limits<double>::infinity();
+      for (int i = n; i--; )
+        if ((lower(b[i]) == -inf) || (upper(b[i]) == inf))
+          return false;
+      Interval h = Interval(t) / static_cast<double>(ode_steps);
+      for (int s = 0; s < ode_steps; s++)
+        if (!step(b,h,ode_halvings))
+          return false;
+      return true;
+    }
+
+    template <class View>
+    ExecStatus
+    Ode<View>::propagate(Space* home, ModEventDelta) {
+      int m = x.size();
+      double w = 0.0;
+      for (int i = 2*n; i--; )
+        w += x[i].max() - x[i].min();
+
+      // The derivatives are kept at zero, see field()
+      Box b(m);
+      for (int i = 2*n; i < m; i++)
+        b[i] = Interval(x[i].min(),x[i].max());
+
+      // Forward: final state from the initial state
+      for (int i = n; i--; ) {
+        b[i] = Interval(x[i].min(),x[i].max());
+        b[n+i] = Interval(0.0);
+      }
+      if (flow(b,t))
+        for (int i = n; i--; ) {
+          GECODE_ME_CHECK(x[n+i].gq(home,lower(b[i])));
+          GECODE_ME_CHECK(x[n+i].lq(home,upper(b[i])));
+        }
+
+      // Backward: initial state from the final state
+      for (int i = n; i--; ) {
+        b[i] = Interval(x[n+i].min(),x[n+i].max());
+        b[n+i] = Interval(0.0);
+      }
+      if (flow(b,-t))
+        for (int i = n; i--; ) {
+          GECODE_ME_CHECK(x[i].gq(home,lower(b[i])));
+          GECODE_ME_CHECK(x[i].lq(home,upper(b[i])));
+        }
+
+      double v = 0.0;
+      for (int i = 2*n; i--; )
+        v += x[i].max() - x[i].min();
+      for (int i = m; i--; )
+        if (!x[i].assigned())
+          return (v < revise_ratio * w) ? ES_NOFIX : ES_FIX;
+      return ES_SUBSUMED(this,home);
+    }
+
+    template <class View>
+    ExecStatus
+    Ode<View>::post(Space* home, const FloatVarArgs& x0,
+                    const FloatVarArgs& dx, const EquationArgs& e,
+                    const FloatVarArgs& y, double t) {
+      int n = x0.size();
+      if ((dx.size() != n) || (e.size() != n) || (y.size() != n))
+        throw ArgumentSizeMismatch("Float::ode");
+      VarIndex vi;
+      for (int i = 0; i < n; i++)
+        (void) vi.index(x0[i].var());
+      for (int i = 0; i < n; i++)
+        (void) vi.index(dx[i].var());
+      if (vi.size() != 2*n)
+        throw ArgumentSame("Float::ode");
+
+      std::vector<Equation> f;
+      for (int i = 0; i < n; i++) {
+        f.push_back(e[i]);
+        f[i].bind(vi);
+      }
+      // Orient equation i as dx_i = f_i, where f_i has no derivative
+      Box u(vi.size());
+      for (int i = vi.size(); i--; )
+        u[i] = Interval(-1.0,1.0);
+      SharedArray<Equation> eqs(n);
+      for (int i = n; i--; ) {
+        Interval d = f[i].derivative(n+i,u);
+        if ((lower(d) == -1.0) && (upper(d) == -1.0))
+          eqs[i] = f[i].reverse();
+        else if ((lower(d) == 1.0) && (upper(d) == 1.0))
+          eqs[i] = f[i];
+        else
+          throw NotDerivative("Float::ode");
+        for (int j = n; j--; )
+          if ((j != i) &&
+              ((lower(f[i].derivative(n+j,u)) != 0.0) ||
+               (upper(f[i].derivative(n+j,u)) != 0.0)))
+            throw NotDerivative("Float::ode");
+      }
+      // The positions of the derivatives hold the final state
+      ViewArray<View> x(home,vi.size());
+      for (int i = vi.size(); i--; )
+        x[i] = View(vi[i]);
+      for (int i = n; i--; )
+        x[n+i] = View(y[i].var());
+      (void) new (home) Ode(home,x,n,eqs,t);
+      return ES_OK;
+    }
+
+  }
+
+  /*
+   * Constraints
+   *
+   */
+
+  /**
+   * \brief Post \f$y=\phi_t(x)\f$ for the flow \f$\phi\f$ of
+   * \f$\dot{x}=f(x)\f$
+   *
+   * Equation \f$i\f$ of \a f must have the form \f$dx_i=f_i\f$ or
+   * \f$f_i=dx_i\f$, where \f$f_i\f$ is an expression over \a x and
+   * possibly further variables acting as parameters. The variables \a dx
+   * only name the derivatives and are not constrained. Throws
+   * NotDerivative if an equation does not have this form.
+   */
+  forceinline void
+  ode(Space* home, const FloatVarArgs& x, const FloatVarArgs& dx,
+      const EquationArgs& f, const FloatVarArgs& y, double t) {
+    if (home->failed()) return;
+    if (Float::Ode<Float::FloatView>::post(home,x,dx,f,y,t) != ES_OK)
+      home->fail();
+  }
+
+}
@@ -0,0 +1,282 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /*
+     * Piecewise linear function
+     *
+     */
+
+    template <class View>
+    forceinline
+    Piecewise<View>::Piecewise(Space* home, View x0, View y0,
+                               SharedArray<double>& xs0,
+                               SharedArray<double>& ys0,
+                               SharedArray<double>& lo0,
+                               SharedArray<double>& hi0)
+      : Propagator(home), x(x0), y(y0), xs(xs0), ys(ys0), lo(lo0), hi(hi0) {
+      x.subscribe(home,this,PC_FLOAT_BND);
+      y.subscribe(home,this,PC_FLOAT_BND);
+      home->notice(this,AP_DISPOSE);
+    }
+
+    template <class View>
+    forceinline
+    Piecewise<View>::Piecewise(Space* home, bool share, Piecewise& p)
+      : Propagator(home,share,p) {
+      x.update(home,share,p.x);
+      y.update(home,share,p.y);
+      xs.update(home,share,p.xs);
+      ys.update(home,share,p.ys);
+      lo.update(home,share,p.lo);
+      hi.update(home,share,p.hi);
+    }
+
+    template <class View>
+    Actor*
+    Piecewise<View>::copy(Space* home, bool share) {
+      return new (home) Piecewise(home,share,*this);
+    }
+
+    template <class View>
+    PropCost
+    Piecewise<View>::cost(ModEventDelta) const {
+      return PC_BINARY_HI;
+    }
+
+    template <class View>
+    size_t
+    Piecewise<View>::dispose(Space* home) {
+      home->ignore(this,AP_DISPOSE);
+      x.cancel(home,this,PC_FLOAT_BND);
+      y.cancel(home,this,PC_FLOAT_BND);
+      xs.~SharedArray();
+      ys.~SharedArray();
+      lo.~SharedArray();
+      hi.~SharedArray();
+      (void) Propagator::dispose(home);
+      return sizeof(*this);
+    }
+
+    template <class View>
+    forceinline int
+    Piecewise<View>::segment(double v) const {
+      int l = 0, u = xs.size() - 2;
+      // Largest segment k with xs[k] <= v
+      while (l < u) {
+        int m = (l + u + 1) / 2;
+        if (xs[m] <= v)
+          l = m;
+        else
+          u = m - 1;
+      }
+      return l;
+    }
+
+    template <class View>
+    forceinline boost::numeric::interval<double>
+    Piecewise<View>::value(int k, double v) const {
+      return ys[k] + (Interval(v) - xs[k]) *
+        (Interval(ys[k+1]) - ys[k]) / (Interval(xs[k+1]) - xs[k]);
+    }
+
+    template <class View>
+    forceinline double
+    Piecewise<View>::rmin(int i, int j) const {
+      int n = xs.size(), k = 0;
+      while ((2 << k) <= j - i + 1)
+        k++;
+      return std::min(lo[k*n+i],lo[k*n+j-(1<<k)+1]);
+    }
+
+    template <class View>
+    forceinline double
+    Piecewise<View>::rmax(int i, int j) const {
+      int n = xs.size(), k = 0;
+      while ((2 << k) <= j - i + 1)
+        k++;
+      return std::max(hi[k*n+i],hi[k*n+j-(1<<k)+1]);
+    }
+
+    template <class View>
+    forceinline boost::numeric::interval<double>
+    Piecewise<View>::reach(int k, double c) const {
+      return xs[k] + (Interval(c) - ys[k]) *
+        (Interval(xs[k+1]) - xs[k]) / (Interval(ys[k+1]) - ys[k]);
+    }
+
+    template <class View>
+    ExecStatus
+    Piecewise<View>::propagate(Space* home, ModEventDelta) {
+      double a = x.min(), b = x.max();
+      int i = segment(a), j = segment(b);
+      Interval fa = value(i,a), fb = value(j,b);
+
+      // Forward: the range of f over [a,b]
+      double yl = std::min(lower(fa),lower(fb));
+      double yu = std::max(upper(fa),upper(fb));
+      if (i < j) {
+        yl = std::min(yl,rmin(i+1,j)); yu = std::max(yu,rmax(i+1,j));
+      }
+      GECODE_ME_CHECK(y.gq(home,yl));
+      GECODE_ME_CHECK(y.lq(home,yu));
+      double c = y.min(), d = y.max();
+
+      // Backward: first point from a where f enters [c,d]
+      double nl = a;
+      if ((lower(fa) > d) || (upper(fa) < c)) {
+        bool above = lower(fa) > d;
+        // Smallest breakpoint m in (a,b] beyond the crossing
+        int l = i+1, u = j+1;
+        while (l < u) {
+          int m = (l + u) / 2;
+          if (above ? (rmin(i+1,m) <= d) : (rmax(i+1,m) >= c))
+            u = m;
+          else
+            l = m + 1;
+        }
+        int k = l - 1;
+        if ((k < j) || (above ? (lower(fb) <= d) : (upper(fb) >= c))) {
+          double s = (k == i) ? a : xs[k];
+          if (ys[k] != ys[k+1])
+            nl = std::max(s,lower(reach(k,above ? d : c)));
+          else
+            nl = s;
+        }
+      }
+
+      // Backward: last point up to b where f leaves [c,d]
+      double nu = b;
+      if ((lower(fb) > d) || (upper(fb) < c)) {
+        bool above = lower(fb) > d;
+        // Largest breakpoint m in (a,b] before the crossing
+        int l = i, u = j;
+        while (l < u) {
+          int m = (l + u + 1) / 2;
+          if (above ? (rmin(m,j) <= d) : (rmax(m,j) >= c))
+            l = m;
+          else
+            u = m - 1;
+        }
+        int k = l;
+        if ((k > i) || (above ? (lower(fa) <= d) : (upper(fa) >= c))) {
+          double e = (k == j) ? b : xs[k+1];
+          if (ys[k] != ys[k+1])
+            nu = std::min(e,upper(reach(k,above ? d : c)));
+          else
+            nu = e;
+        }
+      }
+
+      if (nl > nu)
+        return ES_FAILED;
+      GECODE_ME_CHECK(x.gq(home,nl));
+      GECODE_ME_CHECK(x.lq(home,nu));
+      // Subsume only at a point, an assigned x may still be an interval
+      if (x.min() == x.max()) {
+        Interval v = value(segment(x.min()),x.min());
+        GECODE_ME_CHECK(y.gq(home,lower(v)));
+        GECODE_ME_CHECK(y.lq(home,upper(v)));
+        return ES_SUBSUMED(this,home);
+      }
+      return ((nl > a) || (nu < b)) ? ES_NOFIX : ES_FIX;
+    }
+
+    template <class View>
+    ExecStatus
+    Piecewise<View>::post(Space* home, const FloatArgs& xs0,
+                          const FloatArgs& ys0, View x, View y) {
+      int n = xs0.size();
+      if (n == 0)
+        return ES_FAILED;
+      GECODE_ME_CHECK(x.gq(home,xs0[0]));
+      GECODE_ME_CHECK(x.lq(home,xs0[n-1]));
+      if (n == 1) {
+        GECODE_ME_CHECK(y.gq(home,ys0[0]));
+        GECODE_ME_CHECK(y.lq(home,ys0[0]));
+        return ES_OK;
+      }
+      int levels = 1;
+      while ((2 << (levels-1)) <= n)
+        levels++;
+      SharedArray<double> xs(n), ys(n), lo(levels*n), hi(levels*n);
+      for (int i = n; i--; ) {
+        xs[i] = xs0[i]; ys[i] = ys0[i];
+        lo[i] = hi[i] = ys0[i];
+      }
+      // Envelope: level k holds the extrema of ys[i..i+2^k-1]
+      for (int k = 1; k < levels; k++)
+        for (int i = 0; i + (1 << k) <= n; i++) {
+          int h = 1 << (k-1);
+          lo[k*n+i] = std::min(lo[(k-1)*n+i],lo[(k-1)*n+i+h]);
+          hi[k*n+i] = std::max(hi[(k-1)*n+i],hi[(k-1)*n+i+h]);
+        }
+      (void) new (home) Piecewise(home,x,y,xs,ys,lo,hi);
+      return ES_OK;
+    }
+
+  }
+
+  /*
+   * Constraints
+   *
+   */
+
+  /**
+   * \brief Post \f$y=f(x)\f$ for the piecewise linear \a f through the
+   * points (\a xs, \a ys)
+   *
+   * The abscissae \a xs must be strictly increasing; \a x is restricted
+   * to \f$[xs_0,xs_{n-1}]\f$.
+   */
+  forceinline void
+  piecewise(Space* home, const FloatArgs& xs, const FloatArgs& ys,
+            FloatVar x, FloatVar y) {
+    if (xs.size() != ys.size())
+      throw Float::ArgumentSizeMismatch("Float::piecewise");
+    for (int i = 1; i < xs.size(); i++)
+      if (!(xs[i-1] < xs[i]))
+        throw Float::NotSorted("Float::piecewise");
+    if (home->failed()) return;
+    if (Float::Piecewise<Float::FloatView>::post(home,xs,ys,x,y) != ES_OK)
+      home->fail();
+  }
+
+}
@@ -0,0 +1,216 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /*
+     * Polytope hull contractor
+     *
+     */
+
+    template <class View>
+    forceinline
+    Polytope<View>::Polytope(Space* home, ViewArray<View>& x0,
+                             SharedArray<Equation>& eqs0, int freq0)
+      : Propagator(home), x(x0), eqs(eqs0), freq(freq0), calls(0) {
+      x.subscribe(home,this,PC_FLOAT_BND);
+      home->notice(this,AP_DISPOSE);
+    }
+
+    template <class View>
+    forceinline
+    Polytope<View>::Polytope(Space* home, bool share, Polytope& p)
+      : Propagator(home,share,p), freq(p.freq), calls(p.calls) {
+      x.update(home,share,p.x);
+      eqs.update(home,share,p.eqs);
+    }
+
+    template <class View>
+    Actor*
+    Polytope<View>::copy(Space* home, bool share) {
+      return new (home) Polytope(home,share,*this);
+    }
+
+    template <class View>
+    PropCost
+    Polytope<View>::cost(ModEventDelta) const {
+      return PC_CRAZY_LO;
+    }
+
+    template <class View>
+    size_t
+    Polytope<View>::dispose(Space* home) {
+      home->ignore(this,AP_DISPOSE);
+      x.cancel(home,this,PC_FLOAT_BND);
+      eqs.~SharedArray();
+      (void) Propagator::dispose(home);
+      return sizeof(*this);
+    }
+
+    template <class View>
+    ExecStatus
+    Polytope<View>::propagate(Space* home, ModEventDelta) {
+      if (++calls % freq != 0)
+        return ES_FIX;
+
+      int n = x.size(), m = eqs.size();
+      Box b(n), bc(n);
+      for (int i = n; i--; ) {
+        b[i] = Interval(x[i].min(),x[i].max());
+        bc[i] = Interval(median(b[i]));
+      }
+
+      // Relaxation lo[r] <= g[r] x <= hi[r] of equation r
+      std::vector<double> g(m*n), lo(m), hi(m);
+      for (int r = m; r--; ) {
+        Interval rem = eqs[r].residual(bc);
+        for (int i = n; i--; ) {
+          Interval j = eqs[r].derivative(i,b);
+          g[r*n+i] = median(j);
+          rem += (j - g[r*n+i]) * (b[i] - lower(bc[i]));
+          rem -= Interval(g[r*n+i]) * lower(bc[i]);
+        }
+        lo[r] = -upper(rem); hi[r] = -lower(rem);
+        if ((lo[r] > 0.0) || (hi[r] < 0.0)) {
+          // Rows without linear part must contain zero
+          bool zero = true;
+          for (int i = n; i--; )
+            if (g[r*n+i] != 0.0)
+              zero = false;
+          if (zero)
+            return ES_FAILED;
+        }
+      }
+
+      // Simplex in z = x - lower(b) >= 0: upper rows, lower rows, box rows
+      std::vector<double> a((2*m+n)*n,0.0), rhs(2*m+n);
+      for (int r = m; r--; ) {
+        double s = 0.0;
+        for (int i = n; i--; ) {
+          a[r*n+i] = g[r*n+i];
+          a[(m+r)*n+i] = -g[r*n+i];
+          s += g[r*n+i] * lower(b[i]);
+        }
+        rhs[r] = hi[r] - s;
+        rhs[m+r] = s - lo[r];
+      }
+      for (int i = n; i--; ) {
+        a[(2*m+i)*n+i] = 1.0;
+        rhs[2*m+i] = width(b[i]);
+      }
+
+      for (int j = n; j--; ) {
+        if (width(b[j]) == 0.0)
+          continue;
+        for (int dir = -1; dir <= 1; dir += 2) {
+          std::vector<double> c(n,0.0);
+          c[j] = dir;
+          Simplex lp(a,rhs,c);
+          if (!lp.solve())
+            continue;
+          // Safe bound on max dir*x[j] from the duals of the relaxation rows
+          Interval bound(0.0);
+          std::vector<Interval> red(n);
+          for (int i = n; i--; )
+            red[i] = Interval(c[i]);
+          for (int r = m; r--; ) {
+            double yu = lp.dual(r), yl = lp.dual(m+r);
+            bound += Interval(yu) * hi[r] - Interval(yl) * lo[r];
+            for (int i = n; i--; )
+              red[i] -= Interval(yu) * g[r*n+i] - Interval(yl) * g[r*n+i];
+          }
+          for (int i = n; i--; )
+            bound += red[i] * b[i];
+          Interval h = (dir > 0) ?
+            Interval(-std::numeric_limits<double>::infinity(),upper(bound)) :
+            Interval(-upper(bound),std::numeric_limits<double>::infinity());
+          if (!narrow(b[j],h))
+            return ES_FAILED;
+        }
+      }
+
+      // The relaxation depends on the bounds, so moving them is no fixpoint
+      bool moved = false;
+      for (int i = n; i--; ) {
+        if ((lower(b[i]) != x[i].min()) || (upper(b[i]) != x[i].max()))
+          moved = true;
+        GECODE_ME_CHECK(x[i].gq(home,lower(b[i])));
+        GECODE_ME_CHECK(x[i].lq(home,upper(b[i])));
+      }
+      for (int i = n; i--; )
+        if (!x[i].assigned())
+          return moved ? ES_NOFIX : ES_FIX;
+      return ES_SUBSUMED(this,home);
+    }
+
+    template <class View>
+    ExecStatus
+    Polytope<View>::post(Space* home, const EquationArgs& e, int freq) {
+      if (freq < 1)
+        throw OutOfLimits("Float::polytope");
+      VarIndex vi;
+      SharedArray<Equation> eqs(e.size());
+      for (int i = e.size(); i--; ) {
+        eqs[i] = e[i];
+        eqs[i].bind(vi);
+      }
+      if (vi.size() == 0)
+        return ES_OK;
+      ViewArray<View> x(home,vi.size());
+      for (int i = vi.size(); i--; )
+        x[i] = View(vi[i]);
+      (void) new (home) Polytope(home,x,eqs,freq);
+      return ES_OK;
+    }
+
+  }
+
+  /*
+   * Constraints
+   *
+   */
+
+  forceinline void
+  polytope(Space* home, const EquationArgs& eqs, int freq=1) {
+    if (home->failed()) return;
+    if (Float::Polytope<Float::FloatView>::post(home,eqs,freq) != ES_OK)
+      home->fail();
+  }
+
+}
@@ -0,0 +1,184 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /// Maximal number of HC4 rounds of the presolve
+    const int presolve_rounds = 1024;
+    /// Maximal number of slices shaved at each bound by the presolve
+    const int presolve_shaves = 16;
+    /// Width of the slices shaved by the presolve, relative to the domain
+    const double presolve_slice = 0.05;
+    /// The presolve stops once a round keeps this ratio of the total width
+    const double presolve_ratio = 0.999;
+
+    /**
+     * \brief Run HC4 over \a eqs on box \a b until no bound moves
+     *
+     * Unlike revise(), no round stops on slow convergence. Returns false
+     * if the box is proven to contain no solution.
+     */
+    inline bool
+    presolve_revise(const SharedArray<Equation>& eqs, Box& b) {
+      for (int k = 0; k < presolve_rounds; k++) {
+        Box o(b);
+        for (int e = eqs.size(); e--; )
+          if (!eqs[e].revise(b))
+            return false;
+        bool moved = false;
+        for (int i = b.size(); i--; )
+          if ((lower(b[i]) != lower(o[i])) || (upper(b[i]) != upper(o[i])))
+            moved = true;
+        if (!moved)
+          break;
+      }
+      return true;
+    }
+
+    /**
+     * \brief Shave both bounds of each entry of \a b
+     *
+     * Entries with an infinite bound are not shaved. Returns false if the box is proven to contain no solution.
+     */
+    inline bool
+    presolve_shave(const SharedArray<Equation>& eqs, Box& b) {
+      typedef boost::numeric::interval<double> Interval;
+      for (int i = 0; i < b.size(); i++) {
+        if ((lower(b[i]) <= -std::numeric_limits<double>::max()) ||
+            (upper(b[i]) >= std::numeric_limits<double>::max()))
+          continue;
+        for (int k = 0; (k < presolve_shaves) && (width(b[i]) > 0.0); k++) {
+          double m = lower(b[i]) + presolve_slice * width(b[i]);
+          Box s(b);
+          s[i] = Interval(lower(b[i]),m);
+          if (presolve_revise(eqs,s)) {
+            b[i] = Interval(lower(s[i]),upper(b[i]));
+            break;
+          }
+          b[i] = Interval(m,upper(b[i]));
+          if (!presolve_revise(eqs,b))
+            return false;
+        }
+        for (int k = 0; (k < presolve_shaves) && (width(b[i]) > 0.0); k++) {
+          double m = upper(b[i]) - presolve_slice * width(b[i]);
+          Box s(b);
+          s[i] = Interval(m,upper(b[i]));
+          if (presolve_revise(eqs,s)) {
+            b[i] = Interval(lower(b[i]),upper(s[i]));
+            break;
+          }
+          b[i] = Interval(lower(b[i]),m);
+          if (!presolve_revise(eqs,b))
+            return false;
+        }
+      }
+      return true;
+    }
+
+  }
+
+  /*
+   * Presolve
+   *
+   */
+
+  /**
+   * \brief Tighten the bounds before search with the equations \a e
+   *
+   * Alternates running the propagators posted to \a home to a fixpoint
+   * with HC4 over \a e (and shaving if \a shave is true) until no bound
+   * moves, for at most presolve_rounds rounds and while a round reduces
+   * the total width below presolve_ratio. The HC4 runs ignore the
+   * precision of the variables. Afterwards the equations of \a e are
+   * posted with hc4() if \a post is true. Pass false if the caller
+   * posts them itself, so that they are not posted twice.
+   *
+   * Equations are only entailed over a box if their residual is exactly
+   * zero, which does not happen for boxes of positive width, so no
+   * equation is dropped.
+   */
+  inline void
+  presolve(Space* home, const EquationArgs& e, bool shave=false,
+           bool post=true) {
+    typedef boost::numeric::interval<double> Interval;
+    if (home->failed()) return;
+    Float::VarIndex vi;
+    SharedArray<Float::Equation> eqs(e.size());
+    for (int i = e.size(); i--; ) {
+      eqs[i] = e[i];
+      eqs[i].bind(vi);
+    }
+    int n = vi.size();
+    Float::Box b(n);
+    for (int k = 0; k < Float::presolve_rounds; k++) {
+      if (home->status() == SS_FAILED)
+        return;
+      for (int i = n; i--; )
+        b[i] = Interval(vi[i]->min(),vi[i]->max());
+      Float::Box o(b);
+      if (!Float::presolve_revise(eqs,b) ||
+          (shave && !Float::presolve_shave(eqs,b))) {
+        home->fail();
+        return;
+      }
+      bool moved = false;
+      double w = 0.0, v = 0.0;
+      for (int i = n; i--; ) {
+        Float::FloatView x(vi[i]);
+        if (me_failed(x.gq(home,lower(b[i]))) ||
+            me_failed(x.lq(home,upper(b[i])))) {
+          home->fail();
+          return;
+        }
+        if ((lower(b[i]) != lower(o[i])) || (upper(b[i]) != upper(o[i])))
+          moved = true;
+        w += width(o[i]); v += width(b[i]);
+      }
+      if (!moved ||
+          ((w < std::numeric_limits<double>::infinity()) &&
+           (v >= Float::presolve_ratio * w)))
+        break;
+    }
+
+    if (post)
+      for (int i = 0; i < e.size(); i++)
+        hc4(home,e[i]);
+  }
+
+}
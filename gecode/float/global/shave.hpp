@@ -0,0 +1,251 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /// Maximal number of HC4 rounds over a box
+    const int revise_rounds = 32;
+    /// HC4 rounds stop when the box keeps more than this ratio of its width
+    const double revise_ratio = 0.99;
+    /// Relative width reduction for which adaptive shaving widens
+    const double shave_gain = 0.05;
+
+    /**
+     * \brief Run HC4 over the equations \a f to \a l (exclusive) of
+     * \a eqs on box \a b
+     *
+     * Returns false if the box is proven to contain no solution.
+     */
+    inline bool
+    revise(const SharedArray<Equation>& eqs, int f, int l, Box& b) {
+      for (int k = 0; k < revise_rounds; k++) {
+        double w = 0.0;
+        for (int i = b.size(); i--; )
+          w += width(b[i]);
+        for (int e = l; e-- > f; )
+          if (!eqs[e].revise(b))
+            return false;
+        double v = 0.0;
+        for (int i = b.size(); i--; )
+          v += width(b[i]);
+        if (v >= revise_ratio * w)
+          break;
+      }
+      return true;
+    }
+
+    /**
+     * \brief Run HC4 over the equations \a eqs on box \a b
+     *
+     * Returns false if the box is proven to contain no solution.
+     */
+    forceinline bool
+    revise(const SharedArray<Equation>& eqs, Box& b) {
+      return revise(eqs,0,eqs.size(),b);
+    }
+
+    /*
+     * Shaving
+     *
+     */
+
+    template <class View>
+    forceinline
+    Shave<View>::Shave(Space* home, ViewArray<View>& x0, int n0,
+                       SharedArray<Equation>& eqs0, double slice0,
+                       int budget0, bool adaptive0)
+      : Propagator(home), x(x0), n(n0), eqs(eqs0), slice(slice0),
+        budget(budget0), adaptive(adaptive0), active(n0), start(0),
+        idle(0) {
+      x.subscribe(home,this,PC_FLOAT_BND);
+      home->notice(this,AP_DISPOSE);
+    }
+
+    template <class View>
+    forceinline
+    Shave<View>::Shave(Space* home, bool share, Shave& p)
+      : Propagator(home,share,p), n(p.n), slice(p.slice), budget(p.budget),
+        adaptive(p.adaptive), active(p.active), start(p.start),
+        idle(p.idle) {
+      x.update(home,share,p.x);
+      eqs.update(home,share,p.eqs);
+    }
+
+    template <class View>
+    Actor*
+    Shave<View>::copy(Space* home, bool share) {
+      return new (home) Shave(home,share,*this);
+    }
+
+    template <class View>
+    PropCost
+    Shave<View>::cost(ModEventDelta) const {
+      return PC_CRAZY_HI;
+    }
+
+    template <class View>
+    size_t
+    Shave<View>::dispose(Space* home) {
+      home->ignore(this,AP_DISPOSE);
+      x.cancel(home,this,PC_FLOAT_BND);
+      eqs.~SharedArray();
+      (void) Propagator::dispose(home);
+      return sizeof(*this);
+    }
+
+    template <class View>
+    ExecStatus
+    Shave<View>::propagate(Space* home, ModEventDelta) {
+      Box b(x.size());
+      for (int i = x.size(); i--; )
+        b[i] = Interval(x[i].min(),x[i].max());
+      if (!revise(eqs,b))
+        return ES_FAILED;
+
+      double w = 0.0;
+      for (int i = n; i--; )
+        w += width(b[i]);
+
+      int work = budget;
+      int k = adaptive ? active : n;
+      int t = 0;
+      for ( ; (t < k) && (work > 0); t++) {
+        int i = (start + t) % n;
+        if ((lower(b[i]) <= -std::numeric_limits<double>::max()) ||
+            (upper(b[i]) >= std::numeric_limits<double>::max()))
+          continue;
+        // Shave slices at the lower bound
+        while ((work > 0) && (width(b[i]) > x[i].precision())) {
+          double m = lower(b[i]) + slice * width(b[i]);
+          Box s(b);
+          s[i] = Interval(lower(b[i]),m);
+          work--;
+          if (revise(eqs,s)) {
+            b[i] = Interval(lower(s[i]),upper(b[i]));
+            break;
+          }
+          b[i] = Interval(m,upper(b[i]));
+          if (!revise(eqs,b))
+            return ES_FAILED;
+        }
+        // Shave slices at the upper bound
+        while ((work > 0) && (width(b[i]) > x[i].precision())) {
+          double m = upper(b[i]) - slice * width(b[i]);
+          Box s(b);
+          s[i] = Interval(m,upper(b[i]));
+          work--;
+          if (revise(eqs,s)) {
+            b[i] = Interval(lower(b[i]),upper(s[i]));
+            break;
+          }
+          b[i] = Interval(lower(b[i]),m);
+          if (!revise(eqs,b))
+            return ES_FAILED;
+        }
+      }
+      start = (start + t) % n;
+
+      double v = 0.0;
+      for (int i = n; i--; )
+        v += width(b[i]);
+      if (adaptive) {
+        if ((w > 0.0) && (v < (1.0 - shave_gain) * w))
+          active = std::min(n,2*active);
+        else
+          active = std::max(1,active/2);
+      }
+
+      bool moved = false;
+      for (int i = x.size(); i--; ) {
+        if ((lower(b[i]) != x[i].min()) || (upper(b[i]) != x[i].max()))
+          moved = true;
+        GECODE_ME_CHECK(x[i].gq(home,lower(b[i])));
+        GECODE_ME_CHECK(x[i].lq(home,upper(b[i])));
+      }
+      idle = moved ? 0 : idle + t;
+      for (int i = x.size(); i--; )
+        if (!x[i].assigned())
+          return (moved || ((t > 0) && (idle < n))) ? ES_NOFIX : ES_FIX;
+      return ES_SUBSUMED(this,home);
+    }
+
+    template <class View>
+    ExecStatus
+    Shave<View>::post(Space* home, const EquationArgs& e,
+                      const FloatVarArgs& y, double slice, int budget,
+                      bool adaptive) {
+      if ((slice <= 0.0) || (slice >= 1.0))
+        throw OutOfLimits("Float::shave");
+      VarIndex vi;
+      for (int i = 0; i < y.size(); i++)
+        (void) vi.index(y[i].var());
+      if (vi.size() != y.size())
+        throw ArgumentSame("Float::shave");
+      if (y.size() == 0)
+        return ES_OK;
+
+      SharedArray<Equation> eqs(e.size());
+      for (int i = e.size(); i--; ) {
+        eqs[i] = e[i];
+        eqs[i].bind(vi);
+      }
+      ViewArray<View> x(home,vi.size());
+      for (int i = vi.size(); i--; )
+        x[i] = View(vi[i]);
+      (void) new (home) Shave(home,x,y.size(),eqs,slice,budget,adaptive);
+      return ES_OK;
+    }
+
+  }
+
+  /*
+   * Constraints
+   *
+   */
+
+  forceinline void
+  shave(Space* home, const EquationArgs& eqs, const FloatVarArgs& x,
+        double slice=0.1, int budget=64, bool adaptive=false) {
+    if (home->failed()) return;
+    if (Float::Shave<Float::FloatView>::post(home,eqs,x,slice,budget,
+                                             adaptive) != ES_OK)
+      home->fail();
+  }
+
+}
@@ -0,0 +1,162 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <limits>
+
+namespace Gecode {
+  namespace Float {
+
+    /// Tolerance of the simplex ratio and optimality tests
+    const double simplex_eps = 1e-9;
+    /// Maximal number of pivots per phase (times rows plus columns)
+    const int simplex_pivots = 50;
+
+    /*
+     * Dense simplex
+     *
+     */
+
+    forceinline double&
+    Simplex::at(int i, int j) {
+      return d[i*(n+2)+j];
+    }
+
+    inline
+    Simplex::Simplex(const std::vector<double>& a, const std::vector<double>& b,
+                     const std::vector<double>& c)
+      : m(static_cast<int>(b.size())), n(static_cast<int>(c.size())),
+        bv(m), nv(n+1), d((m+2)*(n+2),0.0) {
+      for (int i = m; i--; ) {
+        for (int j = n; j--; )
+          at(i,j) = a[i*n+j];
+        bv[i] = n+i;
+        at(i,n) = -1.0;
+        at(i,n+1) = b[i];
+      }
+      for (int j = n; j--; ) {
+        nv[j] = j;
+        at(m,j) = -c[j];
+      }
+      nv[n] = -1;
+      at(m+1,n) = 1.0;
+    }
+
+    inline void
+    Simplex::pivot(int r, int s) {
+      double inv = 1.0 / at(r,s);
+      for (int i = m+2; i--; )
+        if ((i != r) && (at(i,s) != 0.0))
+          for (int j = n+2; j--; )
+            if (j != s)
+              at(i,j) -= at(r,j) * at(i,s) * inv;
+      for (int j = n+2; j--; )
+        if (j != s)
+          at(r,j) *= inv;
+      for (int i = m+2; i--; )
+        if (i != r)
+          at(i,s) *= -inv;
+      at(r,s) = inv;
+      std::swap(bv[r],nv[s]);
+    }
+
+    inline bool
+    Simplex::iterate(int p) {
+      int o = (p == 1) ? m+1 : m;
+      for (int k = simplex_pivots * (m+n); k--; ) {
+        // Entering column: most negative reduced cost, smallest index on ties
+        int s = -1;
+        for (int j = 0; j <= n; j++) {
+          if ((p == 2) && (nv[j] == -1))
+            continue;
+          if ((s == -1) || (at(o,j) < at(o,s)) ||
+              ((at(o,j) == at(o,s)) && (nv[j] < nv[s])))
+            s = j;
+        }
+        if (at(o,s) > -simplex_eps)
+          return true;
+        // Leaving row: minimum ratio test
+        int r = -1;
+        for (int i = 0; i < m; i++) {
+          if (at(i,s) < simplex_eps)
+            continue;
+          if ((r == -1) ||
+              (at(i,n+1) / at(i,s) < at(r,n+1) / at(r,s)) ||
+              ((at(i,n+1) / at(i,s) == at(r,n+1) / at(r,s)) &&
+               (bv[i] < bv[r])))
+            r = i;
+        }
+        if (r == -1)
+          return false;
+        pivot(r,s);
+      }
+      return false;
+    }
+
+    inline bool
+    Simplex::solve(void) {
+      int r = 0;
+      for (int i = 1; i < m; i++)
+        if (at(i,n+1) < at(r,n+1))
+          r = i;
+      if ((m > 0) && (at(r,n+1) < -simplex_eps)) {
+        pivot(r,n);
+        if (!iterate(1) || (at(m+1,n+1) < -simplex_eps))
+          return false;
+        for (int i = m; i--; )
+          if (bv[i] == -1) {
+            int s = -1;
+            for (int j = 0; j <= n; j++)
+              if ((s == -1) || (at(i,j) < at(i,s)) ||
+                  ((at(i,j) == at(i,s)) && (nv[j] < nv[s])))
+                s = j;
+            pivot(i,s);
+          }
+      }
+      return iterate(2);
+    }
+
+    inline double
+    Simplex::dual(int i) {
+      for (int j = 0; j <= n; j++)
+        if (nv[j] == n+i)
+          return std::max(0.0,at(m,j));
+      return 0.0;
+    }
+
+  }
+}
@@ -0,0 +1,613 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef __GECODE_FLOAT_SEARCH_HH__
+#define __GECODE_FLOAT_SEARCH_HH__
+
+#include <gecode/float/float.hh>
+#include <gecode/float/branch.hh>
+#include <gecode/float/global.hh>
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <vector>
+
+#include <pthread.h>
+
+/**
+ * \namespace Gecode::Float::Search
+ * \brief %Search engines for float models
+ */
+namespace Gecode {
+  namespace Float {
+    namespace Search {
+
+      /// %Search engine statistics
+      class Statistics {
+      public:
+        /// Number of nodes expanded
+        unsigned long int nodes;
+        /// Number of failed nodes
+        unsigned long int fail;
+        /// Number of clones
+        unsigned long int clone;
+        /// Largest number of open nodes
+        unsigned long int depth;
+        /// Number of nodes stolen from other threads
+        unsigned long int steal;
+        /// Number of subtrees cut as inner boxes
+        unsigned long int inner;
+        /// Number of improvements of the incumbent by probing
+        unsigned long int probe;
+        /// Peak memory used for open nodes (in bytes)
+        size_t memory;
+        /// Initialize
+        Statistics(void);
+      };
+
+      /**
+       * \brief Stack of open boxes
+       *
+       * A box stores the bounds of the \a n variables as \f$2n\f$
+       * contiguous doubles.
+       */
+      class BoxStack {
+      private:
+        /// Number of variables
+        int n;
+        /// The bounds of all boxes
+        std::vector<double> b;
+      public:
+        /// Initialize for boxes of \a n variables
+        BoxStack(int n = 0);
+        /// Return number of boxes
+        unsigned long int size(void) const;
+        /// Return whether the stack is empty
+        bool empty(void) const;
+        /// Push bounds of \a x, with \a x[i] restricted to \f$[l,u]\f$
+        void push(const FloatVarArray& x, int i, double l, double u);
+        /// Push the box at \a d
+        void push(const double* d);
+        /// Return the top box
+        const double* top(void) const;
+        /// Remove the top box
+        void pop(void);
+        /// Remove the bottom box into \a d
+        void shift(double* d);
+        /// Return memory used (in bytes)
+        size_t memory(void) const;
+      };
+
+      /// Kind of box in a paving
+      enum BoxType {
+        BT_INNER,   ///< All points of the box are solutions
+        BT_BOUNDARY ///< The box is narrower than the precision
+      };
+
+      /**
+       * \brief Paving of the solution set
+       *
+       * Inner and boundary boxes are stored as \f$2n\f$ contiguous doubles
+       * each, as in BoxStack. With merging, a new box is joined with the
+       * last box of the same kind if both agree on all variables but one
+       * and touch along that one. Joining is repeated with the boxes
+       * before, so sibling boxes found one after the other by depth-first
+       * search collapse into their parent box.
+       */
+      class Paving {
+      private:
+        /// Number of variables
+        int n;
+        /// Whether adjacent boxes are merged
+        bool merge;
+        /// The inner and boundary boxes
+        std::vector<double> b[2];
+        /// Statistics of the search
+        Statistics stat;
+        /// Join the last two boxes of \a v if possible
+        bool join(std::vector<double>& v) const;
+      public:
+        /// Initialize for boxes of \a n variables
+        Paving(int n = 0, bool merge = false);
+        /// Return number of variables
+        int dimension(void) const;
+        /// Return whether adjacent boxes are merged
+        bool merging(void) const;
+        /// Add the box \a d of kind \a t
+        void add(BoxType t, const double* d);
+        /// Add the bounds of \a x as box of kind \a t
+        void add(BoxType t, const FloatVarArray& x);
+        /// Return number of boxes of kind \a t
+        unsigned long int size(BoxType t) const;
+        /// Return box \a i of kind \a t
+        const double* box(BoxType t, unsigned long int i) const;
+        /// Return total volume of the boxes of kind \a t
+        double volume(BoxType t) const;
+        /// Return memory used (in bytes)
+        size_t memory(void) const;
+        /// Return statistics of the search
+        Statistics& statistics(void);
+        /// Return statistics of the search
+        const Statistics& statistics(void) const;
+      };
+
+      /**
+       * \brief Inner test for boxes
+       *
+       * Holds the constraints \f$f_i\;\mathit{rel}_i\;0\f$ of a model.
+       * A box is inner if the negation of every constraint has no
+       * solution in the box, that is, if the enclosure of every residual
+       * \f$f_i\f$ over the box lies in the relation. All points of an
+       * inner box are solutions, so its subtree need not be bisected.
+       *
+       * \warning The test is only sound if every constraint posted to
+       * the model is added, as a box that satisfies the added constraints
+       * is reported inner even if it violates another one. Keep the
+       * posted equations in an EquationArgs and pass the same array to
+       * the propagators and to add().
+       */
+      class Inner {
+      private:
+        typedef boost::numeric::interval<double> Interval;
+        /// The variables, in the order of the boxes
+        VarIndex vi;
+        /// Number of variables
+        int n;
+        /// The equations, bound to the variables
+        std::vector<Equation> eqs;
+        /// The relation of each equation
+        std::vector<FloatRelType> rel;
+      public:
+        /// Initialize for boxes of the variables \a x
+        Inner(const FloatVarArray& x);
+        /// Add constraint \a e with relation \a r between its sides
+        void add(const Equation& e, FloatRelType r = FRT_EQ);
+        /// Add the constraints \a e, all with relation \a r
+        void add(const EquationArgs& e, FloatRelType r = FRT_EQ);
+        /// Return number of variables
+        int dimension(void) const;
+        /// Return number of constraints
+        int size(void) const;
+        /// Return equation of constraint \a i, bound to the variables
+        const Equation& equation(int i) const;
+        /// Return relation of constraint \a i
+        FloatRelType relation(int i) const;
+        /// Return whether constraint \a i holds on all of \a b
+        bool entailed(int i, const Box& b) const;
+        /// Return whether the box \a d is inner
+        bool inner(const double* d) const;
+        /// Return whether the bounds of \a x form an inner box
+        bool inner(const FloatVarArray& x) const;
+      };
+
+      /**
+       * \brief Upper-bounding probes for branch-and-bound
+       *
+       * Searches a box for a certified feasible point with a small value
+       * of the objective, which is one of the variables of the model. The
+       * inner test \a c must hold all constraints of the model, including
+       * the ones defining the objective, as the value of a point is read
+       * from the objective variable.
+       *
+       * The midpoint and \a samples random points of the box are tried,
+       * and from the best of them a short descent of \a steps steps is
+       * made. The descent follows the negative gradient of the objective
+       * projected onto the tangent space of the equations, with the
+       * derivatives taken as the midpoints of their enclosures (interval
+       * AD) at the point. A step that does not improve is halved.
+       *
+       * Each point is first moved onto the equations by a few Newton
+       * steps in floating point, solving for one variable per equation.
+       * A small box around the point in these variables is then inflated
+       * until a Hansen-Sengupta step maps it into its interior, which
+       * proves that it contains a solution of the equations. The point is
+       * feasible if that box lies in the searched box and all inequality
+       * constraints are entailed on it, and its value is the upper bound
+       * of the objective over the box. Both are rigorous, so the value is
+       * a valid incumbent.
+       */
+      class Probe {
+      private:
+        typedef boost::numeric::interval<double> Interval;
+        /// Number of variables
+        int n;
+        /// Position of the objective
+        int o;
+        /// The constraints
+        const Inner* c;
+        /// The equality constraints of \a c
+        std::vector<Equation> eqs;
+        /// Number of random points
+        unsigned int samples;
+        /// Number of descent steps
+        unsigned int steps;
+        /// State of the random number generator
+        unsigned long int seed;
+        /// Return random number in \f$[0,1]\f$
+        double random(void);
+        /// Return midpoint Jacobian of the equations at \a p into \a j
+        void jacobian(const std::vector<double>& p,
+                      std::vector<double>& j) const;
+        /// Move \a p in box \a d onto the equations, solving for \a v
+        bool project(std::vector<double>& p, const double* d,
+                     std::vector<int>& v) const;
+        /// Prove a feasible point near \a p in box \a d, returning its box \a b
+        bool certify(const std::vector<double>& p, const double* d,
+                     const std::vector<int>& v, Box& b) const;
+        /// Return certified value near \a p (which is moved), infinity if none
+        double value(std::vector<double>& p, const double* d) const;
+      public:
+        /// Initialize for the variables \a x, objective \a f and constraints \a c
+        Probe(const FloatVarArray& x, const FloatVar& f, const Inner& c,
+              unsigned int samples = 4, unsigned int steps = 8);
+        /// Return position of the objective among the variables
+        int objective(void) const;
+        /**
+         * \brief Probe the box \a d
+         *
+         * Returns the value of the best certified point found and stores
+         * the point in \a p, or returns infinity if there is none. The
+         * feasible point lies in a small box around \a p.
+         */
+        double probe(const double* d, std::vector<double>& p);
+      };
+
+      /**
+       * \brief Return the position in \a x of the variable branched on by \a d
+       *
+       * Throws UnknownVariable if the model branches on a variable that
+       * is not in \a x.
+       */
+      int position(const FloatVarArray& x,
+                   const Float::Branch::FloatBranchingDesc& d);
+      /**
+       * \brief Return the choice of \a d over the variables \a x
+       *
+       * The position of the choice is the position in \a x. Throws
+       * NotFloatBranching if \a d does not come from a float branching,
+       * which happens for models that also branch on other variables.
+       */
+      Float::Branch::FloatChoice choice(const FloatVarArray& x,
+                                        const BranchingDesc* d);
+      /// Return bounds \a l, \a u of alternative \a a of \a c, false if empty
+      bool alternative(const FloatVarArray& x,
+                       const Float::Branch::FloatChoice& c, unsigned int a,
+                       double& l, double& u);
+
+      /// Store the bounds of \a x into \a d
+      void store(const FloatVarArray& x, double* d);
+      /// Restrict \a x in \a home to the box \a d, false if failed
+      bool restore(Space* home, FloatVarArray& x, const double* d);
+
+    }
+  }
+
+  /**
+   * \brief Depth-first search storing boxes instead of spaces
+   *
+   * For models whose state is given by the bounds of their float
+   * variables. The model \a T must provide <code>FloatVarArray&
+   * floats(void)</code> returning these variables and must branch with
+   * float branchings (see branch.hh) over variables among them, in any
+   * order. Branching on any other variable throws UnknownVariable, and
+   * any other kind of branching (on integer or Boolean variables, for
+   * example) throws NotFloatBranching.
+   *
+   * A space can only be narrowed, never widened, so the engine keeps a
+   * propagated root space and one working space. Choices are committed
+   * in the working space and each further alternative is pushed as a
+   * box of \f$2n\f$ doubles. Only when the working space fails or is
+   * returned as a solution, the next box is restored into a clone of
+   * the root. Spaces are thus cloned per backtrack and not per choice
+   * point, and open nodes take \f$16n\f$ bytes.
+   */
+  template <class T>
+  class BoxDFS {
+  private:
+    /// The propagated root space
+    T* root;
+    /// The working space
+    T* cur;
+    /// The open boxes
+    Float::Search::BoxStack open;
+    /// Statistics
+    Float::Search::Statistics stat;
+  public:
+    /// Initialize for root space \a s (a clone is taken)
+    BoxDFS(T* s);
+    /// Return next solution, NULL if there is none
+    T* next(void);
+    /// Return statistics
+    Float::Search::Statistics statistics(void) const;
+    /// Destructor
+    ~BoxDFS(void);
+  };
+
+  /**
+   * \brief Interval branch-and-bound search storing boxes
+   *
+   * Minimizes the float variable returned by <code>FloatVar
+   * objective(void)</code> of the model \a T, which must also provide
+   * <code>FloatVarArray& floats(void)</code> as for BoxDFS.
+   *
+   * Only certified values become the incumbent \f$u\f$: the upper bound
+   * of the objective over a leaf (a node in which all branched variables
+   * are assigned) that passes the inner test \a in, and the value of a
+   * feasible point found by the probe \a p, whose objective must be the
+   * objective of the model (or UnknownVariable is thrown). Such leaves
+   * are returned by next() as solutions. A leaf that cannot be certified
+   * may contain no feasible point at all, so it only contributes the
+   * lower bound of its objective to lower().
+   *
+   * Once \f$u\f$ is known, every node is restricted by the cut
+   * \f$\mathit{objective}\leq u-\epsilon\f$ before propagation, where
+   * \f$\epsilon\f$ is the larger of the absolute gap and the relative
+   * gap times \f$|u|\f$. When the search ends, the optimum lies between
+   * lower() and upper(), and lower() is at least \f$u-\epsilon\f$ unless
+   * an uncertified leaf has a smaller objective.
+   *
+   * With best-first exploration, the open node with the smallest lower
+   * bound of the objective is explored next, and the search stops as
+   * soon as this bound reaches the cut. Each node is restored into a
+   * clone of the root. With depth-first exploration, nodes are
+   * explored as by BoxDFS, with one clone per backtrack.
+   */
+  template <class T>
+  class BoxBAB {
+  private:
+    /// Open node for best-first exploration
+    class Node {
+    public:
+      /// Lower bound of the objective
+      double lb;
+      /// Bounds of the variables
+      std::vector<double> box;
+      /// Order nodes for a heap with the smallest lower bound on top
+      bool operator<(const Node& n) const;
+    };
+    /// Whether nodes are explored best-first
+    bool best;
+    /// Absolute optimality gap
+    double abs;
+    /// Relative optimality gap
+    double rel;
+    /// Value of the best certified solution or probed point
+    double ub;
+    /// Smallest objective lower bound of an uncertified leaf
+    double leaf;
+    /// The inner test certifying leaves, if any
+    const Float::Search::Inner* in;
+    /// The probe, if any
+    Float::Search::Probe* pr;
+    /// The best probed point
+    std::vector<double> pt;
+    /// The propagated root space
+    T* root;
+    /// The working space
+    T* cur;
+    /// The open boxes for depth-first exploration
+    Float::Search::BoxStack open;
+    /// The open nodes for best-first exploration, as heap
+    std::vector<Node> heap;
+    /// Statistics
+    Float::Search::Statistics stat;
+    /// Return the bound of the cut
+    double cut(void) const;
+    /// Restore the next open node into \a cur, false if there is none
+    bool restore(void);
+  public:
+    /// Initialize for root space \a s (a clone is taken)
+    BoxBAB(T* s, bool best_first = true, double abs = 1e-6,
+           double rel = 1e-6, const Float::Search::Inner* in = NULL,
+           Float::Search::Probe* p = NULL);
+    /// Return next better certified solution, NULL if there is none
+    T* next(void);
+    /// Return the best probed point, NULL if it is not the incumbent
+    const double* point(void) const;
+    /// Return value of the incumbent, infinity if there is none
+    double upper(void) const;
+    /// Return a lower bound of the objective over all feasible points
+    double lower(void) const;
+    /// Return statistics
+    Float::Search::Statistics statistics(void) const;
+    /// Destructor
+    ~BoxBAB(void);
+  };
+
+  /**
+   * \brief Compute a paving of all solutions of \a s into \a p
+   *
+   * Explores the search tree of \a s like BoxDFS, but adds every
+   * solution as boundary box to \a p instead of returning it, so no
+   * solution space is kept. \a p must be initialized for the number of
+   * variables of \a s.
+   *
+   * If an inner test \a in is given, every node is tested after
+   * propagation. An inner node is added as inner box and its subtree is
+   * cut.
+   */
+  template <class T>
+  void pave(T* s, Float::Search::Paving& p,
+            const Float::Search::Inner* in = NULL);
+
+  /**
+   * \brief Parallel depth-first search with work stealing
+   *
+   * Each thread explores like BoxDFS with its own root and working
+   * space, and keeps its open boxes in a deque. A thread takes work from
+   * the top of its own deque and, if that is empty, steals from the
+   * bottom of the deques of the other threads, where the boxes closest
+   * to the root are. Threads without work wait on a condition variable.
+   * The search ends when no thread works on a node and all deques are
+   * empty.
+   *
+   * The threads start with the first call of next(). Solutions are
+   * passed to next() through a queue of at most parallel_queue
+   * solutions, and threads wait while it is full, so solutions are
+   * returned while the search runs and only few are kept. With \a
+   * deterministic the solutions are returned in the order of sequential
+   * depth-first search, at the price of keeping the path of every open
+   * node and all solutions until the search ends.
+   *
+   * Initialized with a paving, the threads add solutions as boxes to a
+   * paving of their own instead, and next() runs the whole search,
+   * merges the pavings into the given one, and returns NULL. See also
+   * pave().
+   */
+  template <class T>
+  class ParallelDFS {
+  private:
+    /// Open node
+    class Node {
+    public:
+      /// Bounds of the variables
+      std::vector<double> box;
+      /// Alternatives from the root (only with deterministic ordering)
+      std::vector<unsigned int> path;
+    };
+    /// Solution found
+    class Solution {
+    public:
+      /// Alternatives from the root
+      std::vector<unsigned int> path;
+      /// The solution space
+      T* s;
+      /// Order solutions by path
+      bool operator<(const Solution& t) const;
+    };
+    /// Per-thread state
+    class Worker {
+    public:
+      /// The engine
+      ParallelDFS* e;
+      /// Number of the thread
+      unsigned int t;
+      /// The thread
+      pthread_t id;
+      /// The root space of the thread
+      T* root;
+      /// The open nodes
+      std::deque<Node> open;
+      /// Lock for \a open
+      pthread_mutex_t m;
+      /// Boxes found when paving
+      Float::Search::Paving pav;
+      /// Statistics
+      Float::Search::Statistics stat;
+    };
+    /// The workers
+    std::vector<Worker> w;
+    /// Whether solutions are ordered as in sequential search
+    bool deterministic;
+    /// Paving to collect boxes in, if any
+    Float::Search::Paving* pav;
+    /// Inner test when paving, if any
+    const Float::Search::Inner* in;
+    /// Whether the threads have been started
+    bool started;
+    /// Whether the threads have been joined
+    bool joined;
+    /// Whether the threads must stop
+    bool stop;
+    /// Number of open nodes and nodes being explored
+    unsigned long int work;
+    /// Number of nodes in the deques (may be negative for a moment)
+    long int avail;
+    /// Solutions ready for next()
+    std::deque<Solution> sols;
+    /// Lock for \a stop, \a work, \a avail and \a sols
+    pthread_mutex_t m;
+    /// Signals new nodes or the end of the search to the threads
+    pthread_cond_t c_work;
+    /// Signals a new solution or the end of the search to next()
+    pthread_cond_t c_sol;
+    /// Signals room in the solution queue to the threads
+    pthread_cond_t c_room;
+    /// Initialize for root space \a s with \a threads threads
+    void init(T* s, unsigned int threads);
+    /// Take a node for worker \a k into \a n, false if there is none
+    bool take(Worker& k, Node& n);
+    /// Finish a node of worker \a k with solution \a s (NULL if failed)
+    void finish(Worker& k, T* s, const std::vector<unsigned int>& path);
+    /// Explore nodes as worker \a k
+    void explore(Worker& k);
+    /// Thread entry point
+    static void* run(void* k);
+    /// Start the threads
+    void start(void);
+    /// Wait for the threads to end
+    void join(void);
+  public:
+    /// Initialize for root space \a s with \a threads threads
+    ParallelDFS(T* s, unsigned int threads, bool deterministic=false);
+    /// Initialize for paving root space \a s into \a p with \a threads threads
+    ParallelDFS(T* s, unsigned int threads, Float::Search::Paving& p,
+                const Float::Search::Inner* in = NULL);
+    /// Return next solution, NULL if there is none
+    T* next(void);
+    /// Return number of threads
+    unsigned int threads(void) const;
+    /// Return statistics of thread \a t
+    Float::Search::Statistics statistics(unsigned int t) const;
+    /// Destructor
+    ~ParallelDFS(void);
+  };
+
+  /**
+   * \brief Compute a paving of all solutions of \a s into \a p in parallel
+   *
+   * As pave(), but with ParallelDFS using \a threads threads. The
+   * boxes are collected per thread and merged into \a p at the end, so
+   * their order depends on the schedule.
+   */
+  template <class T>
+  void pave(T* s, unsigned int threads, Float::Search::Paving& p,
+            const Float::Search::Inner* in = NULL);
+
+}
+
+#include <gecode/float/search/box.hpp>
+#include <gecode/float/search/dfs.hpp>
+#include <gecode/float/search/bab.hpp>
+#include <gecode/float/search/inner.hpp>
+#include <gecode/float/search/paving.hpp>
+#include <gecode/float/search/probe.hpp>
+#include <gecode/float/search/parallel.hpp>
+
+#endif
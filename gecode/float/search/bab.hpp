@@ -0,0 +1,234 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+
+  /*
+   * Interval branch-and-bound search
+   *
+   */
+
+  template <class T>
+  forceinline bool
+  BoxBAB<T>::Node::operator<(const Node& n) const {
+    return lb > n.lb;
+  }
+
+  template <class T>
+  BoxBAB<T>::BoxBAB(T* s, bool best0, double abs0, double rel0,
+                    const Float::Search::Inner* in0,
+                    Float::Search::Probe* p)
+    : best(best0), abs(abs0), rel(rel0),
+      ub(std::numeric_limits<double>::infinity()),
+      leaf(std::numeric_limits<double>::infinity()), in(in0), pr(p),
+      root(NULL), cur(NULL) {
+    if ((abs < 0.0) || (rel < 0.0))
+      throw Float::OutOfLimits("BoxBAB");
+    if (s->status() == SS_FAILED) {
+      stat.fail++;
+      return;
+    }
+    root = static_cast<T*>(s->clone());
+    if ((pr != NULL) &&
+        (root->floats()[pr->objective()].var() != root->objective().var()))
+      throw Float::UnknownVariable("BoxBAB");
+    open = Float::Search::BoxStack(root->floats().size());
+    cur = static_cast<T*>(root->clone());
+    stat.clone += 2;
+  }
+
+  template <class T>
+  forceinline double
+  BoxBAB<T>::cut(void) const {
+    return ub - std::max(abs,rel*std::abs(ub));
+  }
+
+  template <class T>
+  bool
+  BoxBAB<T>::restore(void) {
+    if (best) {
+      if (heap.empty() || (heap.front().lb > cut()))
+        return false;
+      std::pop_heap(heap.begin(),heap.end());
+      cur = static_cast<T*>(root->clone());
+      (void) Float::Search::restore(cur,cur->floats(),&heap.back().box[0]);
+      heap.pop_back();
+    } else {
+      if (open.empty())
+        return false;
+      cur = static_cast<T*>(root->clone());
+      (void) Float::Search::restore(cur,cur->floats(),open.top());
+      open.pop();
+    }
+    stat.clone++;
+    return true;
+  }
+
+  template <class T>
+  T*
+  BoxBAB<T>::next(void) {
+    using namespace Float::Branch;
+    while (true) {
+      if ((cur == NULL) && !restore())
+        return NULL;
+      if (ub < std::numeric_limits<double>::infinity()) {
+        Float::FloatView o(cur->objective());
+        if (me_failed(o.lq(cur,cut())))
+          cur->fail();
+      }
+      switch (cur->status()) {
+      case SS_FAILED:
+        stat.fail++;
+        delete cur; cur = NULL;
+        break;
+      case SS_SOLVED:
+        {
+          T* s = cur; cur = NULL;
+          if ((in == NULL) || !in->inner(s->floats())) {
+            // Not proven to contain a feasible point, so no incumbent
+            leaf = std::min(leaf,s->objective().min());
+            delete s;
+            break;
+          }
+          double v = s->objective().max();
+          if (v < ub) {
+            ub = v; pt.clear();
+            return s;
+          }
+          delete s;
+        }
+        break;
+      case SS_BRANCH:
+        {
+          stat.nodes++;
+          const BranchingDesc* d = cur->description();
+          FloatVarArray& x = cur->floats();
+          FloatChoice c = Float::Search::choice(x,d);
+          if (pr != NULL) {
+            std::vector<double> b(2*x.size()), p;
+            Float::Search::store(x,&b[0]);
+            double v = pr->probe(&b[0],p);
+            if (v < ub) {
+              ub = v; pt.swap(p);
+              stat.probe++;
+            }
+          }
+          if (best) {
+            // All alternatives become nodes ordered by the lower bound
+            Node n;
+            n.lb = cur->objective().min();
+            n.box.resize(2*x.size());
+            for (unsigned int a = c.alt; a--; ) {
+              double l, u;
+              if (!Float::Search::alternative(x,c,a,l,u))
+                continue;
+              Float::Search::store(x,&n.box[0]);
+              n.box[2*c.pos] = l; n.box[2*c.pos+1] = u;
+              heap.push_back(n);
+              std::push_heap(heap.begin(),heap.end());
+            }
+            delete d;
+            delete cur; cur = NULL;
+            stat.depth = std::max(stat.depth,
+                                  static_cast<unsigned long int>
+                                  (heap.size()));
+            stat.memory = std::max(stat.memory,
+                                   heap.capacity() * sizeof(Node) +
+                                   heap.size() * n.box.size() *
+                                   sizeof(double));
+          } else {
+            for (unsigned int a = c.alt; --a > 0; ) {
+              double l, u;
+              if (Float::Search::alternative(x,c,a,l,u))
+                open.push(x,c.pos,l,u);
+            }
+            cur->commit(d,0);
+            delete d;
+            stat.depth = std::max(stat.depth,open.size());
+            stat.memory = std::max(stat.memory,open.memory());
+          }
+        }
+        break;
+      }
+    }
+  }
+
+  template <class T>
+  forceinline const double*
+  BoxBAB<T>::point(void) const {
+    return pt.empty() ? NULL : &pt[0];
+  }
+
+  template <class T>
+  forceinline double
+  BoxBAB<T>::upper(void) const {
+    return ub;
+  }
+
+  template <class T>
+  double
+  BoxBAB<T>::lower(void) const {
+    double l = std::numeric_limits<double>::infinity();
+    if (ub < l)
+      l = cut();
+    l = std::min(l,leaf);
+    if (cur != NULL)
+      l = std::min(l,cur->objective().min());
+    if (best) {
+      if (!heap.empty())
+        l = std::min(l,heap.front().lb);
+    } else if (!open.empty()) {
+      // The open boxes carry no bounds of the objective
+      l = -std::numeric_limits<double>::infinity();
+    }
+    return l;
+  }
+
+  template <class T>
+  forceinline Float::Search::Statistics
+  BoxBAB<T>::statistics(void) const {
+    return stat;
+  }
+
+  template <class T>
+  BoxBAB<T>::~BoxBAB(void) {
+    delete cur;
+    delete root;
+  }
+
+}
@@ -0,0 +1,159 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode { namespace Float { namespace Search {
+
+  /*
+   * Statistics
+   *
+   */
+
+  forceinline
+  Statistics::Statistics(void)
+    : nodes(0), fail(0), clone(0), depth(0), steal(0), inner(0),
+      probe(0), memory(0) {}
+
+  /*
+   * Box stack
+   *
+   */
+
+  forceinline
+  BoxStack::BoxStack(int n0) : n(n0) {}
+
+  forceinline unsigned long int
+  BoxStack::size(void) const {
+    return (n == 0) ? 0 : b.size() / (2*n);
+  }
+
+  forceinline bool
+  BoxStack::empty(void) const {
+    return b.empty();
+  }
+
+  forceinline void
+  BoxStack::push(const FloatVarArray& x, int i, double l, double u) {
+    size_t s = b.size();
+    b.resize(s + 2*n);
+    store(x,&b[s]);
+    b[s+2*i] = l; b[s+2*i+1] = u;
+  }
+
+  forceinline void
+  BoxStack::push(const double* d) {
+    b.insert(b.end(),d,d+2*n);
+  }
+
+  forceinline const double*
+  BoxStack::top(void) const {
+    return &b[b.size() - 2*n];
+  }
+
+  forceinline void
+  BoxStack::pop(void) {
+    b.resize(b.size() - 2*n);
+  }
+
+  forceinline void
+  BoxStack::shift(double* d) {
+    std::copy(b.begin(),b.begin()+2*n,d);
+    b.erase(b.begin(),b.begin()+2*n);
+  }
+
+  forceinline size_t
+  BoxStack::memory(void) const {
+    return b.capacity() * sizeof(double);
+  }
+
+  /*
+   * Boxes of variables
+   *
+   */
+
+  forceinline int
+  position(const FloatVarArray& x,
+           const Float::Branch::FloatBranchingDesc& d) {
+    int p = d.pos();
+    if ((p >= 0) && (p < x.size()) && (x[p].var() == d.var()))
+      return p;
+    for (int i = x.size(); i--; )
+      if (x[i].var() == d.var())
+        return i;
+    throw UnknownVariable("Float::Search::position");
+  }
+
+  forceinline Float::Branch::FloatChoice
+  choice(const FloatVarArray& x, const BranchingDesc* d) {
+    const Float::Branch::FloatBranchingDesc* fd =
+      dynamic_cast<const Float::Branch::FloatBranchingDesc*>(d);
+    if (fd == NULL)
+      throw NotFloatBranching("Float::Search::choice");
+    // The choice is relative to the views of the branching
+    Float::Branch::FloatChoice c = fd->choice();
+    c.pos = position(x,*fd);
+    return c;
+  }
+
+  forceinline bool
+  alternative(const FloatVarArray& x, const Float::Branch::FloatChoice& c,
+              unsigned int a, double& l, double& u) {
+    l = x[c.pos].min(); u = x[c.pos].max();
+    Float::Branch::bounds(c,a,l,u);
+    return l <= u;
+  }
+
+  forceinline void
+  store(const FloatVarArray& x, double* d) {
+    for (int i = x.size(); i--; ) {
+      d[2*i] = x[i].min(); d[2*i+1] = x[i].max();
+    }
+  }
+
+  forceinline bool
+  restore(Space* home, FloatVarArray& x, const double* d) {
+    for (int i = x.size(); i--; ) {
+      FloatView v(x[i]);
+      if (me_failed(v.gq(home,d[2*i])) || me_failed(v.lq(home,d[2*i+1]))) {
+        home->fail();
+        return false;
+      }
+    }
+    return true;
+  }
+
+}}}
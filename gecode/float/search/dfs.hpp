@@ -0,0 +1,115 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+
+  /*
+   * Box depth-first search
+   *
+   */
+
+  template <class T>
+  BoxDFS<T>::BoxDFS(T* s)
+    : root(NULL), cur(NULL) {
+    if (s->status() == SS_FAILED) {
+      stat.fail++;
+      return;
+    }
+    root = static_cast<T*>(s->clone());
+    open = Float::Search::BoxStack(root->floats().size());
+    cur = static_cast<T*>(root->clone());
+    stat.clone += 2;
+  }
+
+  template <class T>
+  T*
+  BoxDFS<T>::next(void) {
+    using namespace Float::Branch;
+    while (true) {
+      if (cur == NULL) {
+        if (open.empty())
+          return NULL;
+        cur = static_cast<T*>(root->clone());
+        stat.clone++;
+        (void) Float::Search::restore(cur,cur->floats(),open.top());
+        open.pop();
+      }
+      switch (cur->status()) {
+      case SS_FAILED:
+        stat.fail++;
+        delete cur; cur = NULL;
+        break;
+      case SS_SOLVED:
+        {
+          T* s = cur; cur = NULL;
+          return s;
+        }
+      case SS_BRANCH:
+        {
+          stat.nodes++;
+          const BranchingDesc* d = cur->description();
+          FloatVarArray& x = cur->floats();
+          FloatChoice c = Float::Search::choice(x,d);
+          for (unsigned int a = c.alt; --a > 0; ) {
+            double l, u;
+            if (Float::Search::alternative(x,c,a,l,u))
+              open.push(x,c.pos,l,u);
+          }
+          cur->commit(d,0);
+          delete d;
+          stat.depth = std::max(stat.depth,open.size());
+          stat.memory = std::max(stat.memory,open.memory());
+        }
+        break;
+      }
+    }
+  }
+
+  template <class T>
+  forceinline Float::Search::Statistics
+  BoxDFS<T>::statistics(void) const {
+    return stat;
+  }
+
+  template <class T>
+  BoxDFS<T>::~BoxDFS(void) {
+    delete cur;
+    delete root;
+  }
+
+}
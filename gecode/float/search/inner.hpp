@@ -0,0 +1,127 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode { namespace Float { namespace Search {
+
+  /*
+   * Inner test
+   *
+   */
+
+  forceinline
+  Inner::Inner(const FloatVarArray& x) : n(x.size()) {
+    for (int i = 0; i < n; i++)
+      (void) vi.index(x[i].var());
+    if (vi.size() != n)
+      throw ArgumentSame("Float::Search::Inner");
+  }
+
+  forceinline void
+  Inner::add(const Equation& e, FloatRelType r) {
+    // Bind against a copy, so a stray variable does not stay indexed
+    VarIndex v;
+    for (int i = 0; i < n; i++)
+      (void) v.index(vi[i]);
+    Equation f(e);
+    f.bind(v);
+    if (v.size() != n)
+      throw UnknownVariable("Float::Search::Inner::add");
+    eqs.push_back(f);
+    rel.push_back(r);
+  }
+
+  forceinline void
+  Inner::add(const EquationArgs& e, FloatRelType r) {
+    for (int i = 0; i < e.size(); i++)
+      add(e[i],r);
+  }
+
+  forceinline int
+  Inner::dimension(void) const {
+    return n;
+  }
+
+  forceinline int
+  Inner::size(void) const {
+    return static_cast<int>(eqs.size());
+  }
+
+  forceinline const Equation&
+  Inner::equation(int i) const {
+    return eqs[i];
+  }
+
+  forceinline FloatRelType
+  Inner::relation(int i) const {
+    return rel[i];
+  }
+
+  inline bool
+  Inner::entailed(int i, const Box& b) const {
+    Interval r = eqs[i].residual(b);
+    switch (rel[i]) {
+    case FRT_EQ:
+      return (r.lower() == 0.0) && (r.upper() == 0.0);
+    case FRT_LQ:
+      return r.upper() <= 0.0;
+    case FRT_GQ:
+      return r.lower() >= 0.0;
+    default:
+      return false;
+    }
+  }
+
+  inline bool
+  Inner::inner(const double* d) const {
+    Box b(n);
+    for (int i = n; i--; )
+      b[i] = Interval(d[2*i],d[2*i+1]);
+    for (int i = 0; i < size(); i++)
+      if (!entailed(i,b))
+        return false;
+    return true;
+  }
+
+  forceinline bool
+  Inner::inner(const FloatVarArray& x) const {
+    std::vector<double> d(2*n);
+    store(x,&d[0]);
+    return inner(&d[0]);
+  }
+
+}}}
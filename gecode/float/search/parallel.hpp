@@ -0,0 +1,376 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+
+  namespace Float { namespace Search {
+
+    /// Largest number of solutions waiting for ParallelDFS::next()
+    const unsigned int parallel_queue = 64;
+
+  }}
+
+  /*
+   * Parallel depth-first search
+   *
+   */
+
+  template <class T>
+  forceinline bool
+  ParallelDFS<T>::Solution::operator<(const Solution& t) const {
+    return path < t.path;
+  }
+
+  template <class T>
+  void
+  ParallelDFS<T>::init(T* s, unsigned int threads) {
+    w.resize(std::max(1U,threads));
+    pthread_mutex_init(&m,NULL);
+    pthread_cond_init(&c_work,NULL);
+    pthread_cond_init(&c_sol,NULL);
+    pthread_cond_init(&c_room,NULL);
+    bool failed = (s->status() == SS_FAILED);
+    for (unsigned int t = 0; t < w.size(); t++) {
+      w[t].e = this; w[t].t = t;
+      // Unshared clones, as shared data is not reference counted atomically
+      w[t].root = failed ? NULL : static_cast<T*>(s->clone(false));
+      pthread_mutex_init(&w[t].m,NULL);
+      if (pav != NULL)
+        w[t].pav = Float::Search::Paving(pav->dimension(),pav->merging());
+    }
+    if (failed) {
+      w[0].stat.fail++;
+      return;
+    }
+    Node n;
+    n.box.resize(2*w[0].root->floats().size());
+    Float::Search::store(w[0].root->floats(),&n.box[0]);
+    w[0].open.push_back(n);
+    work = 1; avail = 1;
+  }
+
+  template <class T>
+  ParallelDFS<T>::ParallelDFS(T* s, unsigned int threads, bool det)
+    : deterministic(det), pav(NULL), in(NULL), started(false),
+      joined(false), stop(false), work(0), avail(0) {
+    init(s,threads);
+  }
+
+  template <class T>
+  ParallelDFS<T>::ParallelDFS(T* s, unsigned int threads,
+                              Float::Search::Paving& p,
+                              const Float::Search::Inner* in0)
+    : deterministic(false), pav(&p), in(in0), started(false),
+      joined(false), stop(false), work(0), avail(0) {
+    init(s,threads);
+  }
+
+  template <class T>
+  bool
+  ParallelDFS<T>::take(Worker& k, Node& n) {
+    bool got = false;
+    pthread_mutex_lock(&k.m);
+    if (!k.open.empty()) {
+      n = k.open.back(); k.open.pop_back(); got = true;
+    }
+    pthread_mutex_unlock(&k.m);
+    for (unsigned int i = 1; !got && (i < w.size()); i++) {
+      Worker& v = w[(k.t + i) % w.size()];
+      pthread_mutex_lock(&v.m);
+      if (!v.open.empty()) {
+        n = v.open.front(); v.open.pop_front(); got = true;
+        k.stat.steal++;
+      }
+      pthread_mutex_unlock(&v.m);
+    }
+    if (got) {
+      pthread_mutex_lock(&m);
+      avail--;
+      pthread_mutex_unlock(&m);
+    }
+    return got;
+  }
+
+  template <class T>
+  void
+  ParallelDFS<T>::finish(Worker& k, T* s,
+                         const std::vector<unsigned int>& path) {
+    pthread_mutex_lock(&m);
+    if (s != NULL) {
+      Solution o;
+      o.s = s;
+      if (deterministic) {
+        o.path = path;
+      } else {
+        // Wait for room, which next() makes by taking solutions
+        while (!stop && (sols.size() >= Float::Search::parallel_queue))
+          pthread_cond_wait(&c_room,&m);
+      }
+      if (stop)
+        delete s;
+      else
+        sols.push_back(o);
+      pthread_cond_signal(&c_sol);
+    }
+    if (--work == 0) {
+      pthread_cond_broadcast(&c_work);
+      pthread_cond_broadcast(&c_sol);
+    }
+    pthread_mutex_unlock(&m);
+  }
+
+  template <class T>
+  void
+  ParallelDFS<T>::explore(Worker& k) {
+    using namespace Float::Branch;
+    T* cur = NULL;
+    std::vector<unsigned int> path;
+    Node n;
+    while (true) {
+      if (cur == NULL) {
+        if (!take(k,n)) {
+          pthread_mutex_lock(&m);
+          while (!stop && (work > 0) && (avail <= 0))
+            pthread_cond_wait(&c_work,&m);
+          bool finished = stop || (work == 0);
+          pthread_mutex_unlock(&m);
+          if (finished)
+            return;
+          continue;
+        }
+        cur = static_cast<T*>(k.root->clone());
+        k.stat.clone++;
+        (void) Float::Search::restore(cur,cur->floats(),&n.box[0]);
+        path.swap(n.path);
+      }
+      pthread_mutex_lock(&m);
+      bool halt = stop;
+      pthread_mutex_unlock(&m);
+      if (halt) {
+        delete cur;
+        return;
+      }
+      switch (cur->status()) {
+      case SS_FAILED:
+        k.stat.fail++;
+        delete cur; cur = NULL;
+        finish(k,NULL,path);
+        break;
+      case SS_SOLVED:
+        if (pav != NULL) {
+          k.pav.add((in != NULL) && in->inner(cur->floats()) ?
+                    Float::Search::BT_INNER : Float::Search::BT_BOUNDARY,
+                    cur->floats());
+          delete cur; cur = NULL;
+          finish(k,NULL,path);
+        } else {
+          T* s = cur; cur = NULL;
+          finish(k,s,path);
+        }
+        break;
+      case SS_BRANCH:
+        if ((pav != NULL) && (in != NULL) && in->inner(cur->floats())) {
+          k.stat.inner++;
+          k.pav.add(Float::Search::BT_INNER,cur->floats());
+          delete cur; cur = NULL;
+          finish(k,NULL,path);
+        } else {
+          k.stat.nodes++;
+          const BranchingDesc* d = cur->description();
+          FloatVarArray& x = cur->floats();
+          FloatChoice c = Float::Search::choice(x,d);
+          std::vector<Node> alt;
+          for (unsigned int a = c.alt; --a > 0; ) {
+            double l, u;
+            if (!Float::Search::alternative(x,c,a,l,u))
+              continue;
+            Node o;
+            o.box.resize(2*x.size());
+            Float::Search::store(x,&o.box[0]);
+            o.box[2*c.pos] = l; o.box[2*c.pos+1] = u;
+            if (deterministic) {
+              o.path = path; o.path.push_back(a);
+            }
+            alt.push_back(o);
+          }
+          // Count the nodes before they can be stolen
+          pthread_mutex_lock(&m);
+          work += alt.size();
+          pthread_mutex_unlock(&m);
+          pthread_mutex_lock(&k.m);
+          k.open.insert(k.open.end(),alt.begin(),alt.end());
+          k.stat.depth = std::max(k.stat.depth,
+                                  static_cast<unsigned long int>
+                                  (k.open.size()));
+          pthread_mutex_unlock(&k.m);
+          if (!alt.empty()) {
+            pthread_mutex_lock(&m);
+            avail += static_cast<long int>(alt.size());
+            pthread_cond_broadcast(&c_work);
+            pthread_mutex_unlock(&m);
+          }
+          cur->commit(d,0);
+          delete d;
+          if (deterministic)
+            path.push_back(0);
+        }
+        break;
+      }
+    }
+  }
+
+  template <class T>
+  void*
+  ParallelDFS<T>::run(void* k) {
+    Worker* v = static_cast<Worker*>(k);
+    v->e->explore(*v);
+    return NULL;
+  }
+
+  template <class T>
+  void
+  ParallelDFS<T>::start(void) {
+    started = true;
+    for (unsigned int t = 0; t < w.size(); t++)
+      pthread_create(&w[t].id,NULL,&ParallelDFS<T>::run,&w[t]);
+  }
+
+  template <class T>
+  void
+  ParallelDFS<T>::join(void) {
+    if (joined)
+      return;
+    joined = true;
+    for (unsigned int t = 0; started && (t < w.size()); t++)
+      pthread_join(w[t].id,NULL);
+  }
+
+  template <class T>
+  T*
+  ParallelDFS<T>::next(void) {
+    if (!started && !joined && (work > 0))
+      start();
+    if (pav != NULL) {
+      if (!joined) {
+        join();
+        Float::Search::Statistics& s = pav->statistics();
+        for (unsigned int t = 0; t < w.size(); t++) {
+          for (int b = 0; b < 2; b++) {
+            Float::Search::BoxType bt = static_cast<Float::Search::BoxType>(b);
+            for (unsigned long int i = 0; i < w[t].pav.size(bt); i++)
+              pav->add(bt,w[t].pav.box(bt,i));
+          }
+          w[t].pav = Float::Search::Paving();
+          const Float::Search::Statistics& o = w[t].stat;
+          s.nodes += o.nodes; s.fail += o.fail; s.clone += o.clone;
+          s.steal += o.steal; s.inner += o.inner;
+          s.depth = std::max(s.depth,o.depth);
+        }
+      }
+      return NULL;
+    }
+    if (deterministic) {
+      if (!joined) {
+        join();
+        std::sort(sols.begin(),sols.end());
+      }
+    } else {
+      pthread_mutex_lock(&m);
+      while (sols.empty() && (work > 0))
+        pthread_cond_wait(&c_sol,&m);
+      pthread_mutex_unlock(&m);
+    }
+    pthread_mutex_lock(&m);
+    T* s = NULL;
+    if (!sols.empty()) {
+      s = sols.front().s;
+      sols.pop_front();
+      pthread_cond_signal(&c_room);
+    }
+    pthread_mutex_unlock(&m);
+    if (s == NULL)
+      join();
+    return s;
+  }
+
+  template <class T>
+  forceinline unsigned int
+  ParallelDFS<T>::threads(void) const {
+    return w.size();
+  }
+
+  template <class T>
+  forceinline Float::Search::Statistics
+  ParallelDFS<T>::statistics(unsigned int t) const {
+    return w[t].stat;
+  }
+
+  template <class T>
+  ParallelDFS<T>::~ParallelDFS(void) {
+    pthread_mutex_lock(&m);
+    stop = true;
+    pthread_cond_broadcast(&c_work);
+    pthread_cond_broadcast(&c_room);
+    pthread_mutex_unlock(&m);
+    join();
+    for (unsigned int i = 0; i < sols.size(); i++)
+      delete sols[i].s;
+    for (unsigned int t = 0; t < w.size(); t++) {
+      delete w[t].root;
+      pthread_mutex_destroy(&w[t].m);
+    }
+    pthread_cond_destroy(&c_room);
+    pthread_cond_destroy(&c_sol);
+    pthread_cond_destroy(&c_work);
+    pthread_mutex_destroy(&m);
+  }
+
+  /*
+   * Parallel paving
+   *
+   */
+
+  template <class T>
+  void
+  pave(T* s, unsigned int threads, Float::Search::Paving& p,
+       const Float::Search::Inner* in) {
+    ParallelDFS<T> e(s,threads,p,in);
+    (void) e.next();
+  }
+
+}
@@ -0,0 +1,207 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode { namespace Float { namespace Search {
+
+  /*
+   * Paving
+   *
+   */
+
+  forceinline
+  Paving::Paving(int n0, bool merge0) : n(n0), merge(merge0) {}
+
+  forceinline int
+  Paving::dimension(void) const {
+    return n;
+  }
+
+  forceinline bool
+  Paving::merging(void) const {
+    return merge;
+  }
+
+  forceinline bool
+  Paving::join(std::vector<double>& v) const {
+    if (v.size() < 4*static_cast<size_t>(n))
+      return false;
+    double* d = &v[v.size() - 4*n];
+    double* e = d + 2*n;
+    int j = -1;
+    for (int i = n; i--; )
+      if ((d[2*i] != e[2*i]) || (d[2*i+1] != e[2*i+1])) {
+        if (j >= 0)
+          return false;
+        j = i;
+      }
+    if ((j >= 0) && (d[2*j+1] != e[2*j]) && (e[2*j+1] != d[2*j]))
+      return false;
+    if (j >= 0) {
+      d[2*j] = std::min(d[2*j],e[2*j]);
+      d[2*j+1] = std::max(d[2*j+1],e[2*j+1]);
+    }
+    v.resize(v.size() - 2*n);
+    return true;
+  }
+
+  forceinline void
+  Paving::add(BoxType t, const double* d) {
+    std::vector<double>& v = b[t];
+    v.insert(v.end(),d,d+2*n);
+    if (merge)
+      while (join(v)) {}
+  }
+
+  forceinline void
+  Paving::add(BoxType t, const FloatVarArray& x) {
+    std::vector<double>& v = b[t];
+    size_t s = v.size();
+    v.resize(s + 2*n);
+    store(x,&v[s]);
+    if (merge)
+      while (join(v)) {}
+  }
+
+  forceinline unsigned long int
+  Paving::size(BoxType t) const {
+    return (n == 0) ? 0 : b[t].size() / (2*n);
+  }
+
+  forceinline const double*
+  Paving::box(BoxType t, unsigned long int i) const {
+    return &b[t][2*n*i];
+  }
+
+  inline double
+  Paving::volume(BoxType t) const {
+    double s = 0.0;
+    for (unsigned long int k = size(t); k--; ) {
+      const double* d = box(t,k);
+      double v = 1.0;
+      for (int i = n; i--; )
+        v *= d[2*i+1] - d[2*i];
+      s += v;
+    }
+    return s;
+  }
+
+  forceinline size_t
+  Paving::memory(void) const {
+    return (b[BT_INNER].capacity() + b[BT_BOUNDARY].capacity())
+      * sizeof(double);
+  }
+
+  forceinline Statistics&
+  Paving::statistics(void) {
+    return stat;
+  }
+
+  forceinline const Statistics&
+  Paving::statistics(void) const {
+    return stat;
+  }
+
+}}}
+
+namespace Gecode {
+
+  /*
+   * Paving search
+   *
+   */
+
+  template <class T>
+  void
+  pave(T* s, Float::Search::Paving& p, const Float::Search::Inner* in) {
+    using namespace Float::Branch;
+    Float::Search::Statistics& stat = p.statistics();
+    if (s->status() == SS_FAILED) {
+      stat.fail++;
+      return;
+    }
+    T* root = static_cast<T*>(s->clone());
+    Float::Search::BoxStack open(root->floats().size());
+    T* cur = static_cast<T*>(root->clone());
+    stat.clone += 2;
+    while (true) {
+      if (cur == NULL) {
+        if (open.empty())
+          break;
+        cur = static_cast<T*>(root->clone());
+        stat.clone++;
+        (void) Float::Search::restore(cur,cur->floats(),open.top());
+        open.pop();
+      }
+      switch (cur->status()) {
+      case SS_FAILED:
+        stat.fail++;
+        delete cur; cur = NULL;
+        break;
+      case SS_SOLVED:
+        p.add((in != NULL) && in->inner(cur->floats()) ?
+              Float::Search::BT_INNER : Float::Search::BT_BOUNDARY,
+              cur->floats());
+        delete cur; cur = NULL;
+        break;
+      case SS_BRANCH:
+        if ((in != NULL) && in->inner(cur->floats())) {
+          stat.inner++;
+          p.add(Float::Search::BT_INNER,cur->floats());
+          delete cur; cur = NULL;
+        } else {
+          stat.nodes++;
+          const BranchingDesc* d = cur->description();
+          FloatVarArray& x = cur->floats();
+          FloatChoice c = Float::Search::choice(x,d);
+          for (unsigned int a = c.alt; --a > 0; ) {
+            double l, u;
+            if (Float::Search::alternative(x,c,a,l,u))
+              open.push(x,c.pos,l,u);
+          }
+          cur->commit(d,0);
+          delete d;
+          stat.depth = std::max(stat.depth,open.size());
+          stat.memory = std::max(stat.memory,open.memory());
+        }
+        break;
+      }
+    }
+    delete root;
+  }
+
+}
@@ -0,0 +1,252 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode { namespace Float { namespace Search {
+
+  /// Number of Newton steps moving a probed point onto the equations
+  const int probe_newton = 4;
+  /// Initial radius of the box certified around a point, relative to it
+  const double probe_inflate = 1e-10;
+  /// Number of inflations of the certified box, by ten each
+  const int probe_inflations = 6;
+
+  /*
+   * Upper-bounding probes
+   *
+   */
+
+  forceinline
+  Probe::Probe(const FloatVarArray& x, const FloatVar& f, const Inner& c0,
+               unsigned int samples0, unsigned int steps0)
+    : n(x.size()), o(-1), c(&c0), samples(samples0), steps(steps0),
+      seed(1) {
+    if (c0.dimension() != n)
+      throw ArgumentSizeMismatch("Float::Search::Probe");
+    for (int i = n; i--; )
+      if (x[i].var() == f.var())
+        o = i;
+    if (o < 0)
+      throw UnknownVariable("Float::Search::Probe");
+    for (int i = 0; i < c0.size(); i++)
+      if (c0.relation(i) == FRT_EQ)
+        eqs.push_back(c0.equation(i));
+  }
+
+  forceinline int
+  Probe::objective(void) const {
+    return o;
+  }
+
+  forceinline double
+  Probe::random(void) {
+    seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+    return static_cast<double>(seed) / 0x7fffffffUL;
+  }
+
+  inline void
+  Probe::jacobian(const std::vector<double>& p, std::vector<double>& j) const {
+    int k = static_cast<int>(eqs.size());
+    Box b(n);
+    for (int i = n; i--; )
+      b[i] = Interval(p[i]);
+    j.resize(k*n);
+    for (int r = k; r--; )
+      for (int s = n; s--; )
+        j[r*n+s] = median(eqs[r].derivative(s,b));
+  }
+
+  inline bool
+  Probe::project(std::vector<double>& p, const double* d,
+                 std::vector<int>& v) const {
+    int k = static_cast<int>(eqs.size());
+    v.clear();
+    if (k == 0)
+      return true;
+    if (k > n)
+      return false;
+    for (int t = 0; t < probe_newton; t++) {
+      std::vector<double> j;
+      jacobian(p,j);
+      if (t == 0) {
+        // One variable per equation, by elimination with column pivoting
+        std::vector<double> a(j);
+        std::vector<bool> used(n,false);
+        for (int r = 0; r < k; r++) {
+          int q = -1;
+          for (int s = 0; s < n; s++)
+            if (!used[s] && ((q < 0) || (fabs(a[r*n+s]) > fabs(a[r*n+q]))))
+              q = s;
+          if (a[r*n+q] == 0.0)
+            return false;
+          used[q] = true; v.push_back(q);
+          for (int h = r+1; h < k; h++) {
+            double g = a[h*n+q] / a[r*n+q];
+            for (int s = n; s--; )
+              a[h*n+s] -= g * a[r*n+s];
+          }
+        }
+      }
+      Box b(n);
+      for (int i = n; i--; )
+        b[i] = Interval(p[i]);
+      std::vector<double> m(k*k), y(k*k), f(k);
+      for (int r = k; r--; ) {
+        f[r] = median(eqs[r].residual(b));
+        for (int s = k; s--; )
+          m[r*k+s] = j[r*n+v[s]];
+      }
+      if (!midinverse(k,m,y))
+        return false;
+      for (int s = k; s--; ) {
+        double e = 0.0;
+        for (int r = k; r--; )
+          e += y[s*k+r] * f[r];
+        int i = v[s];
+        p[i] = std::min(d[2*i+1],std::max(d[2*i],p[i] - e));
+      }
+    }
+    return true;
+  }
+
+  inline bool
+  Probe::certify(const std::vector<double>& p, const double* d,
+                 const std::vector<int>& v, Box& b) const {
+    double w = probe_inflate;
+    for (int t = 0; t <= probe_inflations; t++, w *= 10.0) {
+      for (int i = n; i--; )
+        b[i] = Interval(p[i]);
+      for (unsigned int s = 0; s < v.size(); s++) {
+        double r = w * std::max(1.0,fabs(p[v[s]]));
+        b[v[s]] = Interval(p[v[s]]) + Interval(-r,r);
+      }
+      bool unique = v.empty();
+      if (!unique && !hansen_sengupta(eqs,v,b,unique))
+        return false;
+      if (!unique)
+        continue;
+      // The box holds a solution of the equations, check the rest
+      for (int i = n; i--; )
+        if ((lower(b[i]) < d[2*i]) || (upper(b[i]) > d[2*i+1]))
+          return false;
+      for (int i = 0; i < c->size(); i++)
+        if ((c->relation(i) != FRT_EQ) && !c->entailed(i,b))
+          return false;
+      return true;
+    }
+    return false;
+  }
+
+  inline double
+  Probe::value(std::vector<double>& p, const double* d) const {
+    std::vector<int> v;
+    Box b(n);
+    if (!project(p,d,v) || !certify(p,d,v,b))
+      return std::numeric_limits<double>::infinity();
+    return upper(b[o]);
+  }
+
+  inline double
+  Probe::probe(const double* d, std::vector<double>& p) {
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> q(n);
+    double best = inf;
+    for (unsigned int k = 0; k <= samples; k++) {
+      for (int i = n; i--; ) {
+        double l = d[2*i], u = d[2*i+1];
+        if ((l <= -std::numeric_limits<double>::max()) ||
+            (u >= std::numeric_limits<double>::max()))
+          return best;
+        q[i] = (k == 0) ? l / 2 + u / 2 : l + random() * (u - l);
+      }
+      double v = value(q,d);
+      if (v < best) {
+        best = v; p = q;
+      }
+    }
+    if (!(best < inf))
+      return best;
+    // Descent from the best point, staying inside the box
+    double t = 0.0;
+    for (int i = n; i--; )
+      t = std::max(t,d[2*i+1] - d[2*i]);
+    t /= 2;
+    int k = static_cast<int>(eqs.size());
+    for (unsigned int s = 0; (s < steps) && (t > 0.0); s++) {
+      // Gradient of the objective projected onto the tangent space
+      std::vector<double> g(n,0.0);
+      g[o] = 1.0;
+      if (k > 0) {
+        std::vector<double> j, m(k*k), y(k*k), jg(k);
+        jacobian(p,j);
+        for (int r = k; r--; ) {
+          jg[r] = j[r*n+o];
+          for (int h = k; h--; ) {
+            m[r*k+h] = 0.0;
+            for (int i = n; i--; )
+              m[r*k+h] += j[r*n+i] * j[h*n+i];
+          }
+        }
+        if (!midinverse(k,m,y))
+          break;
+        for (int r = k; r--; ) {
+          double l = 0.0;
+          for (int h = k; h--; )
+            l += y[r*k+h] * jg[h];
+          for (int i = n; i--; )
+            g[i] -= j[r*n+i] * l;
+        }
+      }
+      double z = 0.0;
+      for (int i = n; i--; )
+        z += g[i] * g[i];
+      if (!(z > 0.0))
+        break;
+      z = std::sqrt(z);
+      for (int i = n; i--; )
+        q[i] = std::min(d[2*i+1],std::max(d[2*i],p[i] - t * g[i] / z));
+      double v = value(q,d);
+      if (v < best) {
+        best = v; p = q;
+      } else {
+        t /= 2;
+      }
+    }
+    return best;
+  }
+
+}}}
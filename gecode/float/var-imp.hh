@@ -68,6 +68,62 @@ namespace Gecode {
     public:
       EmptyDomain(const char* l) : Exception(l, "Empty domain") {}
     };
+
+    /// Exception: value is out of limits
+    class GECODE_VTABLE_EXPORT OutOfLimits : public Exception {
+    public:
+      OutOfLimits(const char* l)
+        : Exception(l, "Number out of limits") {}
+    };
+
+    /// Exception: equation is not polynomial
+    class GECODE_VTABLE_EXPORT NotPolynomial : public Exception {
+    public:
+      NotPolynomial(const char* l)
+        : Exception(l, "Equation is not polynomial") {}
+    };
+
+    /// Exception: sizes of argument arrays mismatch
+    class GECODE_VTABLE_EXPORT ArgumentSizeMismatch : public Exception {
+    public:
+      ArgumentSizeMismatch(const char* l)
+        : Exception(l, "Sizes of argument arrays mismatch") {}
+    };
+
+    /// Exception: arguments contain same variable multiply
+    class GECODE_VTABLE_EXPORT ArgumentSame : public Exception {
+    public:
+      ArgumentSame(const char* l)
+        : Exception(l, "Argument array contains same variable multiply") {}
+    };
+
+    /// Exception: argument array is not sorted
+    class GECODE_VTABLE_EXPORT NotSorted : public Exception {
+    public:
+      NotSorted(const char* l)
+        : Exception(l, "Argument array is not strictly increasing") {}
+    };
+
+    /// Exception: equation contains a variable not in the argument array
+    class GECODE_VTABLE_EXPORT UnknownVariable : public Exception {
+    public:
+      UnknownVariable(const char* l)
+        : Exception(l, "Equation contains variable not in argument array") {}
+    };
+
+    /// Exception: equation does not define a derivative
+    class GECODE_VTABLE_EXPORT NotDerivative : public Exception {
+    public:
+      NotDerivative(const char* l)
+        : Exception(l, "Equation does not have the form dx=f(x)") {}
+    };
+
+    /// Exception: branching does not branch on float variables
+    class GECODE_VTABLE_EXPORT NotFloatBranching : public Exception {
+    public:
+      NotFloatBranching(const char* l)
+        : Exception(l, "Branching does not branch on float variables") {}
+    };
     
     /**
      * \brief Implementation of graph variables.
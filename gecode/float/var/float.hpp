@@ -105,7 +105,51 @@ namespace Gecode {
   forceinline Float::Operation
   FloatVar::operator+(Float::Operation exp) {
     Float::ExpresionView *v = new Float::ExpresionView(*this);
-    return Float::Operation(home,*v,exp,'+');
+    return Float::Operation(home,*v,*new Float::Operation(exp),'+');
+  }
+
+  forceinline Float::Operation
+  FloatVar::operator-(FloatVar exp) {
+    Float::ExpresionView *v1 = new Float::ExpresionView(*this);
+    Float::ExpresionView *v2 = new Float::ExpresionView(exp);
+    return Float::Operation(home,*v1,*v2,'-');
+  }
+
+  forceinline Float::Operation
+  FloatVar::operator-(Float::Operation exp) {
+    Float::ExpresionView *v = new Float::ExpresionView(*this);
+    return Float::Operation(home,*v,*new Float::Operation(exp),'-');
+  }
+
+  forceinline Float::Operation
+  FloatVar::operator*(FloatVar exp) {
+    Float::ExpresionView *v1 = new Float::ExpresionView(*this);
+    Float::ExpresionView *v2 = new Float::ExpresionView(exp);
+    return Float::Operation(home,*v1,*v2,'*');
+  }
+
+  forceinline Float::Operation
+  FloatVar::operator*(Float::Operation exp) {
+    Float::ExpresionView *v = new Float::ExpresionView(*this);
+    return Float::Operation(home,*v,*new Float::Operation(exp),'*');
+  }
+
+  forceinline Float::Operation
+  FloatVar::operator+(double c) {
+    Float::ExpresionView *v = new Float::ExpresionView(*this);
+    return Float::Operation(home,*v,*new Float::ConstExpresion(c),'+');
+  }
+
+  forceinline Float::Operation
+  FloatVar::operator-(double c) {
+    Float::ExpresionView *v = new Float::ExpresionView(*this);
+    return Float::Operation(home,*v,*new Float::ConstExpresion(c),'-');
+  }
+
+  forceinline Float::Operation
+  FloatVar::operator*(double c) {
+    Float::ExpresionView *v = new Float::ExpresionView(*this);
+    return Float::Operation(home,*v,*new Float::ConstExpresion(c),'*');
   }
 
   forceinline Float::Equation
@@ -118,7 +162,13 @@ namespace Gecode {
   forceinline Float::Equation
   FloatVar::operator=(Float::Operation exp) {
     Float::ExpresionView *v = new Float::ExpresionView(*this);
-    return Float::Equation(home,*v,exp);
+    return Float::Equation(home,*v,*new Float::Operation(exp));
+  }
+
+  forceinline Float::Equation
+  FloatVar::operator=(double c) {
+    Float::ExpresionView *v = new Float::ExpresionView(*this);
+    return Float::Equation(home,*v,*new Float::ConstExpresion(c));
   }
 
   forceinline void
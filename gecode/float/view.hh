@@ -36,7 +36,11 @@
  *
  */
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <vector>
 
 namespace Gecode { 
   namespace Float {
@@ -104,6 +108,8 @@ namespace Gecode {
       double max(void) const;
       // Return median of domain
       double med(void) const;
+      // Return precision of the variable
+      float precision(void) const;
       //@}
 
       /// \name Reflection
@@ -124,10 +130,130 @@ namespace Gecode {
     class Operation;
     class Equation;
 
+    /**
+     * \brief Box of intervals for the variables of a set of expressions
+     *
+     * Expressions refer to the entries of a box by the positions assigned
+     * by a VarIndex. Evaluating over a box does not depend on the space
+     * the expression was built in.
+     */
+    class Box {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
+      /// Number of entries
+      int n;
+      /// The intervals
+      Interval* d;
+    public:
+      /// \name Constructors and initialization
+      //@{
+      /// Create box of \a n entries
+      Box(int n);
+      /// Copy constructor
+      Box(const Box& b);
+      /// Assignment operator
+      Box& operator=(const Box& b);
+      /// Destructor
+      ~Box(void);
+      //@}
+
+      /// \name Access
+      //@{
+      /// Return number of entries
+      int size(void) const;
+      /// Return entry \a i
+      Interval& operator[](int i);
+      /// Return entry \a i
+      const Interval& operator[](int i) const;
+      //@}
+    };
+
+    /// Intersect \a x with \a y, returns false if the result is empty
+    bool narrow(boost::numeric::interval<double>& x,
+                const boost::numeric::interval<double>& y);
+
+    /**
+     * \brief Mapping from float variables to positions in a Box
+     *
+     * Used at post time to bind the leaves of expressions to the
+     * variable array of the propagator they are posted with.
+     */
+    class VarIndex {
+    private:
+      /// The indexed variables
+      Support::DynamicArray<FloatVarImp*> x;
+      /// Number of indexed variables
+      int n;
+    public:
+      /// Default constructor
+      VarIndex(void);
+      /// Return position of \a y, adding it if not yet indexed
+      int index(FloatVarImp* y);
+      /// Return number of indexed variables
+      int size(void) const;
+      /// Return variable at position \a i
+      FloatVarImp* operator[](int i) const;
+    };
+
+    /**
+     * \brief Affine form over the entries of a Box
+     *
+     * Represents \f$c + \sum_i a_i\epsilon_i + e\eta\f$ where each noise
+     * symbol \f$\epsilon_i\f$ belongs to box entry \a i. Rounding errors
+     * and nonlinear terms are accumulated in the error radius \a e, so
+     * the range of a form is a rigorous enclosure.
+     */
+    class Affine {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
+      /// Center
+      double c;
+      /// Partial deviations, one per box entry
+      std::vector<double> a;
+      /// Error radius
+      double e;
+      /// Set \a v to the midpoint of \a r and add its width to the error
+      void round(double& v, const Interval& r);
+    public:
+      /// \name Constructors and initialization
+      //@{
+      /// Constant form \a v over \a n noise symbols
+      Affine(int n, double v=0.0);
+      /// Form for an enclosure \a r without correlation to any entry
+      Affine(int n, const Interval& r);
+      /// Form for entry \a i of box \a b
+      Affine(const Box& b, int i);
+      //@}
+
+      /// \name Arithmetic
+      //@{
+      Affine operator+(const Affine& y) const;
+      Affine operator-(const Affine& y) const;
+      Affine operator*(const Affine& y) const;
+      //@}
+
+      /// Return the range of the form
+      Interval range(void) const;
+      /**
+       * \brief Narrow the box \a b the form is over to where it can be zero
+       *
+       * Solves \f$a_i\epsilon_i\in -(c+\sum_{j\neq i}a_j\epsilon_j+e\eta)\f$
+       * for each noise symbol and maps the result back to entry \a i.
+       * The box must be the one the form was computed over. Returns
+       * false if the form cannot be zero.
+       */
+      bool project(Box& b) const;
+    };
+
+    class Polynomial;
+
     class Expresion {
     protected:
       typedef boost::numeric::interval<double> Interval;
     public:
+      /// Destructor
+      virtual ~Expresion(void) {}
+
       /// \name Value access
       //@{
       // Return minimun of domain
@@ -143,11 +269,37 @@ namespace Gecode {
       virtual void evaluation() {};
       virtual void propagation(double l,double u) {}
       virtual void show() {};
+
+      /// \name Evaluation over a box
+      //@{
+      /// Return a deep copy of the expression tree
+      virtual Expresion* clone(void) const { return new Expresion(*this); }
+      /// Bind the variables of the expression to positions in \a vi
+      virtual void bind(VarIndex& vi) {}
+      /// Return the enclosure of the expression over \a b
+      virtual Interval image(const Box& b) const { return Interval(min(),max()); }
+      /// Return the enclosure of the derivative w.r.t. entry \a i over \a b
+      virtual Interval derivative(int i, const Box& b) const { return Interval(0.0); }
+      /// Narrow \a b such that the expression lies in \a r, false if empty
+      virtual bool project(Box& b, const Interval& r) const { return true; }
+      /// Return the affine form of the expression over \a b
+      virtual Affine affine(const Box& b) const { return Affine(b.size(),image(b)); }
+      //@}
+
+      /// \name Rewriting
+      //@{
+      /// Expand into \a p over the variables in \a vi, false if not possible
+      virtual bool polynomial(VarIndex& vi, Polynomial& p) const { return false; }
+      /// Return the number of variable occurrences
+      virtual int occurrences(void) const { return 0; }
+      //@}
     };
 
     class ExpresionView : public VarViewBase<FloatVarImp>,public Expresion {
     protected:
       using VarViewBase<FloatVarImp>::varimp;
+      /// Position in the box the view is bound to
+      int idx;
     public:
 
       /// \name Constructor and initialization
@@ -162,10 +314,6 @@ namespace Gecode {
       ExpresionView(Space* home, const Reflection::VarMap& vars, Reflection::Arg* arg);
       //@}
 
-      ~ExpresionView() {
-        std::cout<<"killed";
-      }
-
       /// \name Subscribe
       //@{
       /// Subscribe this view
@@ -208,6 +356,22 @@ namespace Gecode {
       double med(void) const;
       //@}
 
+      /// \name Evaluation over a box
+      //@{
+      Expresion* clone(void) const;
+      void bind(VarIndex& vi);
+      Interval image(const Box& b) const;
+      Interval derivative(int i, const Box& b) const;
+      bool project(Box& b, const Interval& r) const;
+      Affine affine(const Box& b) const;
+      //@}
+
+      /// \name Rewriting
+      //@{
+      bool polynomial(VarIndex& vi, Polynomial& p) const;
+      int occurrences(void) const;
+      //@}
+
       /// \name Reflection
       //@{
       /// Return specification for this view, using variable map \a m
@@ -222,12 +386,28 @@ namespace Gecode {
       char type;
       Interval eva;
       Space* home;
+      /// Whether the operands are deleted with the operation
+      bool own;
     public:
-      Operation(Space* home,Expresion &op1,Expresion &op2,char type);
+      /// Initialize, deleting the operands on destruction if \a own
+      Operation(Space* home,Expresion &op1,Expresion &op2,char type,
+                bool own=false);
+      /// Copy constructor, the copy does not own the operands
+      Operation(const Operation& o);
+      /// Destructor
+      ~Operation(void);
       Operation operator+(FloatVar exp);
       Operation operator+(Operation exp);
+      Operation operator-(FloatVar exp);
+      Operation operator-(Operation exp);
+      Operation operator*(FloatVar exp);
+      Operation operator*(Operation exp);
+      Operation operator+(double c);
+      Operation operator-(double c);
+      Operation operator*(double c);
       Equation  operator=(FloatVar exp);
       Equation  operator=(Operation exp);
+      Equation  operator=(double c);
 
       /// \name Value access
       //@{
@@ -244,19 +424,189 @@ namespace Gecode {
       void evaluation();
       void propagation(double l,double u);
       void show();
+
+      /// \name Evaluation over a box
+      //@{
+      Expresion* clone(void) const;
+      void bind(VarIndex& vi);
+      Interval image(const Box& b) const;
+      Interval derivative(int i, const Box& b) const;
+      bool project(Box& b, const Interval& r) const;
+      Affine affine(const Box& b) const;
+      //@}
+
+      /// \name Rewriting
+      //@{
+      bool polynomial(VarIndex& vi, Polynomial& p) const;
+      int occurrences(void) const;
+      //@}
+    };
+
+    /**
+     * \brief Constant in expressions
+     *
+     * Constants are kept as intervals, so folding them stays rigorous.
+     */
+    class ConstExpresion : public Expresion {
+    private:
+      /// The value
+      Interval c;
+    public:
+      /// Initialize with value \a c
+      ConstExpresion(double c);
+      /// Initialize with enclosure \a c
+      ConstExpresion(const Interval& c);
+
+      /// \name Value access
+      //@{
+      // Return minimun of value
+      double min(void) const;
+      // Return maximun of value
+      double max(void) const;
+      // Return median of value
+      double med(void) const;
+      //@}
+
+      void show();
+
+      /// \name Evaluation over a box
+      //@{
+      Expresion* clone(void) const;
+      Interval image(const Box& b) const;
+      Interval derivative(int i, const Box& b) const;
+      bool project(Box& b, const Interval& r) const;
+      Affine affine(const Box& b) const;
+      //@}
+
+      /// \name Rewriting
+      //@{
+      bool polynomial(VarIndex& vi, Polynomial& p) const;
+      //@}
+    };
+
+    /**
+     * \brief Polynomial over the variables of a VarIndex
+     *
+     * Monomials are sorted sequences of variable positions, so \f$x^2y\f$
+     * is \f$[x,x,y]\f$. Coefficients are intervals.
+     */
+    class Polynomial {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
+      typedef std::vector<int> Monomial;
+      typedef std::map<Monomial,Interval> Terms;
+      /// The nonzero terms
+      Terms t;
+      /// Add coefficient \a c to monomial \a m
+      void add(const Monomial& m, const Interval& c);
+      /// Build Horner form of terms \a u over the variables \a vi
+      static Expresion* horner(Space* home, const Terms& u, const VarIndex& vi);
+    public:
+      /// Polynomial zero
+      Polynomial(void);
+      /// Set to the constant \a c
+      void constant(const Interval& c);
+      /// Set to the variable at position \a i
+      void variable(int i);
+      /// Add \a q times \a s
+      void add(const Polynomial& q, double s);
+      /// Multiply by \a q
+      void mul(const Polynomial& q);
+      /// Return the number of terms
+      int size(void) const;
+      /// Return the degree in the variable at position \a i
+      int degree(int i) const;
+      /// Return an expression in multivariate Horner form
+      Expresion* horner(Space* home, const VarIndex& vi) const;
+      /**
+       * \brief Compute the Bernstein coefficients over box \a b
+       *
+       * The coefficients for degrees \a d are stored in \a c with
+       * the index of the first variable varying fastest.
+       */
+      void bernstein(const Box& b, const std::vector<int>& d,
+                     std::vector<Interval>& c) const;
     };
 
     class Equation {
+    protected:
+      typedef boost::numeric::interval<double> Interval;
     private:
       Space* home;
-      Expresion &ex1,&ex2;
+      Expresion *ex1,*ex2;
+      /// Evaluation mode of the forward pass
+      FloatEvalMode fem;
+      /// Number of copies sharing owned sides, NULL if the sides are not owned
+      unsigned int* use;
+      /// Return the enclosure of \a ex over \a b in the evaluation mode
+      Interval enclosure(const Expresion* ex, const Box& b) const;
+      /// Give up this copy's share of owned sides
+      void release(void);
     public:
+      Equation(void);
       Equation(Space* home,Expresion &ex1,Expresion &ex2);
+      /// Copy constructor, sharing the sides
+      Equation(const Equation& e);
+      /**
+       * \brief Assignment operator, sharing the sides
+       *
+       * Argument and shared arrays assign to uninitialized elements, so
+       * the previous sides of the equation are not released. Assign only
+       * to equations without owned sides.
+       */
+      Equation& operator=(const Equation& e);
+      /// Destructor, deleting owned sides with the last copy
+      ~Equation(void);
       void subscribe(Space* home,Propagator* p,PropCond pc);
       void update(Space* home,bool share,Propagator& p);
       void evaluation();
       void propagation();
       void show();
+
+      /// \name Evaluation over a box
+      //@{
+      /**
+       * \brief Bind the variables of both sides to positions in \a vi
+       *
+       * Both sides are copied first, so other copies of the equation,
+       * which share the expression trees, keep their own binding. The
+       * copies are owned by the equation and its copies, and deleted
+       * with the last of them.
+       */
+      void bind(VarIndex& vi);
+      /// Return the enclosure of the residual (left minus right side) over \a b
+      Interval residual(const Box& b) const;
+      /// Return the enclosure of the residual derivative w.r.t. entry \a i over \a b
+      Interval derivative(int i, const Box& b) const;
+      /// Narrow \a b by one forward-backward (HC4) pass, false if empty
+      bool revise(Box& b) const;
+      /// Return the equation with both sides exchanged
+      Equation reverse(void) const;
+      //@}
+
+      /// \name Rewriting
+      //@{
+      /// Expand the residual into \a p over the variables in \a vi
+      bool polynomial(VarIndex& vi, Polynomial& p) const;
+      /**
+       * \brief Return an equivalent equation with fewer occurrences
+       *
+       * Both sides are expanded into one polynomial, which flattens sums
+       * and products and folds constants, and rebuilt in multivariate
+       * Horner form. The equation itself is returned if it is not
+       * polynomial, too large, or the rewriting does not reduce the
+       * number of occurrences.
+       */
+      Equation rewrite(void) const;
+      //@}
+
+      /// \name Evaluation mode
+      //@{
+      /// Set evaluation mode of the forward pass to \a m
+      void mode(FloatEvalMode m);
+      /// Return evaluation mode of the forward pass
+      FloatEvalMode mode(void) const;
+      //@}
     };
 
   }
@@ -389,7 +739,10 @@ namespace Gecode {
 #include <gecode/float/view/print.hpp>
 #include <gecode/float/view/minus.hpp>
 #include <gecode/float/view/zero.hpp>
+#include <gecode/float/view/box.hpp>
+#include <gecode/float/view/affine.hpp>
 #include <gecode/float/view/expresion.hpp>
+#include <gecode/float/view/rewrite.hpp>
 
 #include <gecode/float/var/float.hpp>
 #include <gecode/float/var/array.hpp>
@@ -0,0 +1,143 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /*
+     * Affine forms
+     *
+     */
+
+    forceinline void
+    Affine::round(double& v, const Interval& r) {
+      v = median(r);
+      double d = std::max(upper(Interval(upper(r)) - v),
+                          upper(Interval(v) - lower(r)));
+      e = upper(Interval(e) + d);
+    }
+
+    forceinline
+    Affine::Affine(int n, double v) : c(v), a(n,0.0), e(0.0) {}
+
+    forceinline
+    Affine::Affine(int n, const Interval& r) : c(0.0), a(n,0.0), e(0.0) {
+      round(c,r);
+    }
+
+    forceinline
+    Affine::Affine(const Box& b, int i)
+      : c(median(b[i])), a(b.size(),0.0), e(0.0) {
+      // Radius rounded up towards both bounds
+      a[i] = std::max(upper(Interval(upper(b[i])) - c),
+                      upper(Interval(c) - lower(b[i])));
+    }
+
+    forceinline Affine
+    Affine::operator+(const Affine& y) const {
+      Affine z(static_cast<int>(a.size()));
+      z.e = upper(Interval(e) + y.e);
+      z.round(z.c,Interval(c) + y.c);
+      for (int i = static_cast<int>(a.size()); i--; )
+        z.round(z.a[i],Interval(a[i]) + y.a[i]);
+      return z;
+    }
+
+    forceinline Affine
+    Affine::operator-(const Affine& y) const {
+      Affine z(static_cast<int>(a.size()));
+      z.e = upper(Interval(e) + y.e);
+      z.round(z.c,Interval(c) - y.c);
+      for (int i = static_cast<int>(a.size()); i--; )
+        z.round(z.a[i],Interval(a[i]) - y.a[i]);
+      return z;
+    }
+
+    forceinline Affine
+    Affine::operator*(const Affine& y) const {
+      Affine z(static_cast<int>(a.size()));
+      // Radii of both forms, rounded up
+      Interval rx(e), ry(y.e);
+      for (int i = static_cast<int>(a.size()); i--; ) {
+        rx += fabs(a[i]); ry += fabs(y.a[i]);
+      }
+      // Quadratic terms and propagated errors go to the error radius
+      z.e = upper(rx * ry + Interval(fabs(c)) * y.e + Interval(fabs(y.c)) * e);
+      z.round(z.c,Interval(c) * y.c);
+      for (int i = static_cast<int>(a.size()); i--; )
+        z.round(z.a[i],Interval(c) * y.a[i] + Interval(y.c) * a[i]);
+      return z;
+    }
+
+    forceinline boost::numeric::interval<double>
+    Affine::range(void) const {
+      Interval r(e);
+      for (int i = static_cast<int>(a.size()); i--; )
+        r += fabs(a[i]);
+      return Interval(c) + Interval(-upper(r),upper(r));
+    }
+
+    forceinline bool
+    Affine::project(Box& b) const {
+      Interval s(e);
+      for (int i = static_cast<int>(a.size()); i--; )
+        s += fabs(a[i]);
+      if (!(upper(s) < std::numeric_limits<double>::infinity()))
+        return zero_in(range());
+      for (int i = static_cast<int>(a.size()); i--; ) {
+        if ((a[i] == 0.0) ||
+            (lower(b[i]) <= -std::numeric_limits<double>::max()) ||
+            (upper(b[i]) >= std::numeric_limits<double>::max()))
+          continue;
+        // Radius of all other terms, rounded up
+        double r = upper(Interval(upper(s)) - fabs(a[i]));
+        Interval t = (Interval(-c) + Interval(-r,r)) / Interval(a[i]);
+        if (!narrow(t,Interval(-1.0,1.0)))
+          return false;
+        // Center and radius of entry i as used by Affine(b,i)
+        double m = median(b[i]);
+        double d = std::max(upper(Interval(upper(b[i])) - m),
+                            upper(Interval(m) - lower(b[i])));
+        if (!narrow(b[i],Interval(m) + Interval(d) * t))
+          return false;
+      }
+      return true;
+    }
+
+  }
+}
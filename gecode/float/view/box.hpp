@@ -0,0 +1,132 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /*
+     * Box
+     *
+     */
+
+    forceinline
+    Box::Box(int n0) : n(n0), d(new Interval[n0]) {}
+
+    forceinline
+    Box::Box(const Box& b) : n(b.n), d(new Interval[b.n]) {
+      for (int i = n; i--; )
+        d[i] = b.d[i];
+    }
+
+    forceinline Box&
+    Box::operator=(const Box& b) {
+      if (this != &b) {
+        if (n != b.n) {
+          delete [] d;
+          n = b.n;
+          d = new Interval[n];
+        }
+        for (int i = n; i--; )
+          d[i] = b.d[i];
+      }
+      return *this;
+    }
+
+    forceinline
+    Box::~Box(void) {
+      delete [] d;
+    }
+
+    forceinline int
+    Box::size(void) const {
+      return n;
+    }
+
+    forceinline boost::numeric::interval<double>&
+    Box::operator[](int i) {
+      assert((i >= 0) && (i < n));
+      return d[i];
+    }
+
+    forceinline const boost::numeric::interval<double>&
+    Box::operator[](int i) const {
+      assert((i >= 0) && (i < n));
+      return d[i];
+    }
+
+    forceinline bool
+    narrow(boost::numeric::interval<double>& x,
+           const boost::numeric::interval<double>& y) {
+      double l = std::max(lower(x),lower(y));
+      double u = std::min(upper(x),upper(y));
+      if (l > u)
+        return false;
+      x = boost::numeric::interval<double>(l,u);
+      return true;
+    }
+
+    /*
+     * Variable index
+     *
+     */
+
+    forceinline
+    VarIndex::VarIndex(void) : n(0) {}
+
+    forceinline int
+    VarIndex::index(FloatVarImp* y) {
+      for (int i = 0; i < n; i++)
+        if (x[i] == y)
+          return i;
+      x[n] = y;
+      return n++;
+    }
+
+    forceinline int
+    VarIndex::size(void) const {
+      return n;
+    }
+
+    forceinline FloatVarImp*
+    VarIndex::operator[](int i) const {
+      assert((i >= 0) && (i < n));
+      return x[i];
+    }
+
+  }
+}
@@ -155,20 +155,95 @@ namespace Gecode {
       return Support::Symbol("Gecode::Float::ExpresionView");
     }
 
+    /*
+     * Evaluation over a box
+     *
+     */
+
+    forceinline Expresion*
+    ExpresionView::clone(void) const {
+      return new ExpresionView(*this);
+    }
+
+    forceinline void
+    ExpresionView::bind(VarIndex& vi) {
+      idx = vi.index(varimp);
+    }
+
+    forceinline boost::numeric::interval<double>
+    ExpresionView::image(const Box& b) const {
+      return b[idx];
+    }
+
+    forceinline boost::numeric::interval<double>
+    ExpresionView::derivative(int i, const Box&) const {
+      return Interval(i == idx ? 1.0 : 0.0);
+    }
+
+    forceinline bool
+    ExpresionView::project(Box& b, const Interval& r) const {
+      return narrow(b[idx],r);
+    }
+
+    forceinline Affine
+    ExpresionView::affine(const Box& b) const {
+      return Affine(b,idx);
+    }
+
     forceinline
-    Operation::Operation(Space* home,Expresion &op1,Expresion &op2,char type) : op1(op1),op2(op2),home(home) {
+    Operation::Operation(Space* home,Expresion &op1,Expresion &op2,char type,
+                         bool own)
+      : op1(op1),op2(op2),type(type),home(home),own(own) {
       evaluation();
     }
 
+    forceinline
+    Operation::Operation(const Operation& o)
+      : Expresion(o),op1(o.op1),op2(o.op2),type(o.type),eva(o.eva),
+        home(o.home),own(false) {
+    }
+
+    forceinline
+    Operation::~Operation(void) {
+      if (own) {
+        delete &op1; delete &op2;
+      }
+    }
+
+    /*
+     * Operands are copied to the heap as the operation only keeps
+     * references to them.
+     *
+     */
+
     forceinline
     Operation Operation::operator+(FloatVar exp) {
-      ExpresionView v(exp);
-      return Operation(home,*this,v,'+');
+      return Operation(home,*new Operation(*this),*new ExpresionView(exp),'+');
     }
 
     forceinline
     Operation Operation::operator+(Operation exp) {
-      return Operation(home,*this,exp,'+');
+      return Operation(home,*new Operation(*this),*new Operation(exp),'+');
+    }
+
+    forceinline
+    Operation Operation::operator-(FloatVar exp) {
+      return Operation(home,*new Operation(*this),*new ExpresionView(exp),'-');
+    }
+
+    forceinline
+    Operation Operation::operator-(Operation exp) {
+      return Operation(home,*new Operation(*this),*new Operation(exp),'-');
+    }
+
+    forceinline
+    Operation Operation::operator*(FloatVar exp) {
+      return Operation(home,*new Operation(*this),*new ExpresionView(exp),'*');
+    }
+
+    forceinline
+    Operation Operation::operator*(Operation exp) {
+      return Operation(home,*new Operation(*this),*new Operation(exp),'*');
     }
 
     forceinline Equation
@@ -180,7 +255,27 @@ namespace Gecode {
 
     forceinline Equation
     Operation::operator=(Operation exp) {
-      return Equation(home,*this,exp);
+      return Equation(home,*new Operation(*this),*new Operation(exp));
+    }
+
+    forceinline
+    Operation Operation::operator+(double c) {
+      return Operation(home,*new Operation(*this),*new ConstExpresion(c),'+');
+    }
+
+    forceinline
+    Operation Operation::operator-(double c) {
+      return Operation(home,*new Operation(*this),*new ConstExpresion(c),'-');
+    }
+
+    forceinline
+    Operation Operation::operator*(double c) {
+      return Operation(home,*new Operation(*this),*new ConstExpresion(c),'*');
+    }
+
+    forceinline Equation
+    Operation::operator=(double c) {
+      return Equation(home,*new Operation(*this),*new ConstExpresion(c));
     }
 
     forceinline void
@@ -202,6 +297,10 @@ namespace Gecode {
       switch(type) {
       case '+':
         eva = Interval( op1.min()+op2.min() , op1.max()+op2.max() );  break;
+      case '-':
+        eva = Interval( op1.min()-op2.max() , op1.max()-op2.min() );  break;
+      case '*':
+        eva = Interval(op1.min(),op1.max()) * Interval(op2.min(),op2.max());  break;
       }
     }
 
@@ -220,6 +319,34 @@ namespace Gecode {
         if (u<l) return;
         op2.propagation(l,u);
 
+        break;
+      case '-':
+        l = rl+op2.min();
+        u = ru+op2.max();
+        if (u<l) return;
+        op1.propagation(l,u);
+
+        l = op1.min()-ru;
+        u = op1.max()-rl;
+        if (u<l) return;
+        op2.propagation(l,u);
+
+        break;
+      case '*':
+        {
+          Interval r(rl,ru);
+          Interval d1(op1.min(),op1.max());
+          Interval d2(op2.min(),op2.max());
+          if (!zero_in(d2)) {
+            d1 = r / d2;
+            op1.propagation(lower(d1),upper(d1));
+          }
+          d1 = Interval(op1.min(),op1.max());
+          if (!zero_in(d1)) {
+            d2 = r / d1;
+            op2.propagation(lower(d2),upper(d2));
+          }
+        }
         break;
       }
     }
@@ -248,14 +375,177 @@ namespace Gecode {
       return lower(eva);
     }
 
+    /*
+     * Evaluation over a box
+     *
+     */
+
+    forceinline Expresion*
+    Operation::clone(void) const {
+      return new Operation(home,*op1.clone(),*op2.clone(),type,true);
+    }
+
+    forceinline void
+    Operation::bind(VarIndex& vi) {
+      op1.bind(vi);
+      op2.bind(vi);
+    }
+
+    forceinline boost::numeric::interval<double>
+    Operation::image(const Box& b) const {
+      switch(type) {
+      case '+': return op1.image(b) + op2.image(b);
+      case '-': return op1.image(b) - op2.image(b);
+      case '*': return op1.image(b) * op2.image(b);
+      }
+      return eva;
+    }
+
+    forceinline boost::numeric::interval<double>
+    Operation::derivative(int i, const Box& b) const {
+      switch(type) {
+      case '+': return op1.derivative(i,b) + op2.derivative(i,b);
+      case '-': return op1.derivative(i,b) - op2.derivative(i,b);
+      case '*':
+        return op1.derivative(i,b) * op2.image(b) +
+          op1.image(b) * op2.derivative(i,b);
+      }
+      return Interval(0.0);
+    }
+
+    forceinline bool
+    Operation::project(Box& b, const Interval& r) const {
+      Interval i1 = op1.image(b);
+      Interval i2 = op2.image(b);
+      switch(type) {
+      case '+':
+        if (!op1.project(b,r - i2)) return false;
+        i1 = op1.image(b);
+        return op2.project(b,r - i1);
+      case '-':
+        if (!op1.project(b,r + i2)) return false;
+        i1 = op1.image(b);
+        return op2.project(b,i1 - r);
+      case '*':
+        if (!zero_in(i2) && !op1.project(b,r / i2)) return false;
+        i1 = op1.image(b);
+        if (!zero_in(i1) && !op2.project(b,r / i1)) return false;
+        return true;
+      }
+      return true;
+    }
+
+    forceinline Affine
+    Operation::affine(const Box& b) const {
+      switch(type) {
+      case '+': return op1.affine(b) + op2.affine(b);
+      case '-': return op1.affine(b) - op2.affine(b);
+      case '*': return op1.affine(b) * op2.affine(b);
+      }
+      return Affine(b.size(),image(b));
+    }
+
+    /*
+     * Constants
+     *
+     */
+
     forceinline
-    Equation::Equation(Space* home,Expresion& ex1,Expresion& ex2) : ex1(ex1),ex2(ex2),home(home) {
+    ConstExpresion::ConstExpresion(double c0) : c(c0) {}
+
+    forceinline
+    ConstExpresion::ConstExpresion(const Interval& c0) : c(c0) {}
+
+    forceinline double
+    ConstExpresion::min(void) const {
+      return lower(c);
+    }
+
+    forceinline double
+    ConstExpresion::max(void) const {
+      return upper(c);
+    }
+
+    forceinline double
+    ConstExpresion::med(void) const {
+      return median(c);
+    }
+
+    forceinline void
+    ConstExpresion::show() {
+      std::cout<<"["<<lower(c)<<","<<upper(c)<<"]";
+    }
+
+    forceinline Expresion*
+    ConstExpresion::clone(void) const {
+      return new ConstExpresion(*this);
+    }
+
+    forceinline boost::numeric::interval<double>
+    ConstExpresion::image(const Box&) const {
+      return c;
+    }
+
+    forceinline boost::numeric::interval<double>
+    ConstExpresion::derivative(int, const Box&) const {
+      return Interval(0.0);
+    }
+
+    forceinline bool
+    ConstExpresion::project(Box&, const Interval& r) const {
+      return (lower(r) <= upper(c)) && (lower(c) <= upper(r));
+    }
+
+    forceinline Affine
+    ConstExpresion::affine(const Box& b) const {
+      return Affine(b.size(),c);
+    }
+
+    forceinline
+    Equation::Equation(void)
+      : home(NULL), ex1(NULL), ex2(NULL), fem(FEM_NATURAL), use(NULL) {
+    }
+
+    forceinline
+    Equation::Equation(Space* home,Expresion& ex1,Expresion& ex2)
+      : home(home),ex1(&ex1),ex2(&ex2),fem(FEM_NATURAL),use(NULL) {
+    }
+
+    forceinline
+    Equation::Equation(const Equation& e)
+      : home(e.home),ex1(e.ex1),ex2(e.ex2),fem(e.fem),use(e.use) {
+      if (use != NULL)
+        (*use)++;
+    }
+
+    forceinline Equation&
+    Equation::operator=(const Equation& e) {
+      // The target may be uninitialized memory, so it is not released
+      if (this != &e) {
+        if (e.use != NULL)
+          (*e.use)++;
+        home = e.home; ex1 = e.ex1; ex2 = e.ex2; fem = e.fem; use = e.use;
+      }
+      return *this;
+    }
+
+    forceinline void
+    Equation::release(void) {
+      if ((use != NULL) && (--(*use) == 0)) {
+        delete ex1; delete ex2; delete use;
+      }
+      use = NULL;
+    }
+
+    forceinline
+    Equation::~Equation(void) {
+      release();
     }
 
     forceinline void
     Equation::subscribe(Space* home,Propagator* p,PropCond pc) {
-      ex1.subscribe(home,p,pc);
-      ex2.subscribe(home,p,pc);
+      ex1->subscribe(home,p,pc);
+      ex2->subscribe(home,p,pc);
     }
 
     forceinline void
@@ -266,24 +556,93 @@ namespace Gecode {
 
     forceinline void
     Equation::evaluation() {
-      ex1.evaluation();
-      ex2.evaluation();
+      ex1->evaluation();
+      ex2->evaluation();
     }
 
     forceinline void
     Equation::propagation() {
-      double l = ex1.min()>ex2.min()?ex1.min():ex2.min();
-      double u = ex1.max()<ex2.max()?ex1.max():ex2.max();
+      double l = ex1->min()>ex2->min()?ex1->min():ex2->min();
+      double u = ex1->max()<ex2->max()?ex1->max():ex2->max();
 
       if (u<l) return;
 
-      ex1.propagation(l,u);
-      ex2.propagation(l,u);
+      ex1->propagation(l,u);
+      ex2->propagation(l,u);
     }
 
     forceinline void
     Equation::show() {
-      ex1.show(); std::cout<<" = "; ex2.show(); std::cout<<std::endl;
+      ex1->show(); std::cout<<" = "; ex2->show(); std::cout<<std::endl;
+    }
+
+    forceinline void
+    Equation::bind(VarIndex& vi) {
+      Expresion* e1 = ex1->clone();
+      Expresion* e2 = ex2->clone();
+      release();
+      ex1 = e1; ex2 = e2; use = new unsigned int(1);
+      ex1->bind(vi);
+      ex2->bind(vi);
+    }
+
+    forceinline boost::numeric::interval<double>
+    Equation::enclosure(const Expresion* ex, const Box& b) const {
+      Interval r = ex->image(b);
+      if (fem == FEM_AFFINE) {
+        Interval ra = ex->affine(b).range();
+        // Both are enclosures, so they always intersect
+        (void) narrow(r,ra);
+      }
+      return r;
+    }
+
+    forceinline boost::numeric::interval<double>
+    Equation::residual(const Box& b) const {
+      if (fem == FEM_AFFINE) {
+        Interval r = ex1->image(b) - ex2->image(b);
+        (void) narrow(r,(ex1->affine(b) - ex2->affine(b)).range());
+        return r;
+      }
+      return ex1->image(b) - ex2->image(b);
+    }
+
+    forceinline boost::numeric::interval<double>
+    Equation::derivative(int i, const Box& b) const {
+      return ex1->derivative(i,b) - ex2->derivative(i,b);
+    }
+
+    forceinline bool
+    Equation::revise(Box& b) const {
+      if (fem == FEM_AFFINE) {
+        if (!zero_in(residual(b)))
+          return false;
+        // Project through the affine form before the natural HC4 pass
+        Affine f = ex1->affine(b) - ex2->affine(b);
+        if (!f.project(b))
+          return false;
+      }
+      Interval r = enclosure(ex1,b);
+      if (!narrow(r,enclosure(ex2,b)))
+        return false;
+      return ex1->project(b,r) && ex2->project(b,r);
+    }
+
+    forceinline Equation
+    Equation::reverse(void) const {
+      Equation r(*this);
+      std::swap(r.ex1,r.ex2);
+      return r;
+    }
+
+    forceinline void
+    Equation::mode(FloatEvalMode m) {
+      fem = m;
+    }
+
+    forceinline FloatEvalMode
+    Equation::mode(void) const {
+      return fem;
     }
 
   }
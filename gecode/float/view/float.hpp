@@ -131,6 +131,11 @@ namespace Gecode {
       return varimp->med();
     }
 
+    forceinline float
+    FloatView::precision(void) const {
+      return varimp->precision();
+    }
+
     /*
      * Serialization
      *
@@ -0,0 +1,297 @@
+/* -*- mode: C++; c-basic-offset: 2; indent-tabs-mode: nil -*- */
+/*
+ *  Main authors:
+ *     Yves Jaradin      <yves.jaradin@uclouvain.be>
+ *     Gustavo Gutierrez <gutierrez.gustavo@uclouvain.be>
+ *
+ *  Copyright:
+ *     Yves Jaradin, 2009
+ *     Gustavo Gutierrez, 2009
+ *
+ *  Last modified:
+ *     $Date$ by $Author$
+ *     $Revision$
+ *
+ *  This file is part of CP(Graph), a constraint system on graph veriables for
+ *  Gecode: http://www.gecode.org  
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+namespace Gecode {
+  namespace Float {
+
+    /// Largest number of terms of a polynomial considered for rewriting
+    const int rewrite_terms = 128;
+
+    /*
+     * Polynomials
+     *
+     */
+
+    forceinline
+    Polynomial::Polynomial(void) {}
+
+    forceinline void
+    Polynomial::add(const Monomial& m, const Interval& c) {
+      Terms::iterator i = t.find(m);
+      if (i == t.end()) {
+        t.insert(std::make_pair(m,c));
+      } else {
+        i->second += c;
+        if ((lower(i->second) == 0.0) && (upper(i->second) == 0.0))
+          t.erase(i);
+      }
+    }
+
+    forceinline void
+    Polynomial::constant(const Interval& c) {
+      t.clear();
+      if ((lower(c) != 0.0) || (upper(c) != 0.0))
+        t.insert(std::make_pair(Monomial(),c));
+    }
+
+    forceinline void
+    Polynomial::variable(int i) {
+      t.clear();
+      t.insert(std::make_pair(Monomial(1,i),Interval(1.0)));
+    }
+
+    forceinline void
+    Polynomial::add(const Polynomial& q, double s) {
+      for (Terms::const_iterator i = q.t.begin(); i != q.t.end(); ++i)
+        add(i->first,s * i->second);
+    }
+
+    forceinline void
+    Polynomial::mul(const Polynomial& q) {
+      Polynomial p;
+      for (Terms::const_iterator i = t.begin(); i != t.end(); ++i)
+        for (Terms::const_iterator j = q.t.begin(); j != q.t.end(); ++j) {
+          Monomial m(i->first.size() + j->first.size());
+          std::merge(i->first.begin(),i->first.end(),
+                     j->first.begin(),j->first.end(),m.begin());
+          p.add(m,i->second * j->second);
+        }
+      t.swap(p.t);
+    }
+
+    forceinline int
+    Polynomial::size(void) const {
+      return static_cast<int>(t.size());
+    }
+
+    forceinline int
+    Polynomial::degree(int i) const {
+      int d = 0;
+      for (Terms::const_iterator j = t.begin(); j != t.end(); ++j)
+        d = std::max(d,static_cast<int>(std::count(j->first.begin(),
+                                                    j->first.end(),i)));
+      return d;
+    }
+
+    /// Return the binomial coefficient \a n over \a k
+    forceinline double
+    binomial(int n, int k) {
+      double c = 1.0;
+      for (int i = 1; i <= k; i++)
+        c = c * (n - k + i) / i;
+      return c;
+    }
+
+    inline void
+    Polynomial::bernstein(const Box& b, const std::vector<int>& d,
+                          std::vector<Interval>& c) const {
+      int n = static_cast<int>(d.size());
+      std::vector<int> stride(n+1);
+      stride[0] = 1;
+      for (int k = 0; k < n; k++)
+        stride[k+1] = stride[k] * (d[k]+1);
+      c.assign(stride[n],Interval(0.0));
+
+      // Power form over the unit box, substituting x = l + w t
+      std::vector<int> e(n), j(n);
+      for (Terms::const_iterator m = t.begin(); m != t.end(); ++m) {
+        for (int k = n; k--; )
+          e[k] = j[k] = 0;
+        for (unsigned int k = 0; k < m->first.size(); k++)
+          e[m->first[k]]++;
+        // Enumerate all multi-indices j <= e
+        while (true) {
+          Interval a = m->second;
+          int idx = 0;
+          for (int k = n; k--; ) {
+            Interval l(lower(b[k]));
+            Interval w = Interval(upper(b[k])) - l;
+            a *= binomial(e[k],j[k]) * pow(l,e[k]-j[k]) * pow(w,j[k]);
+            idx += j[k] * stride[k];
+          }
+          c[idx] += a;
+          int k = 0;
+          while ((k < n) && (j[k] == e[k]))
+            j[k++] = 0;
+          if (k == n)
+            break;
+          j[k]++;
+        }
+      }
+
+      // Convert each dimension from power to Bernstein basis
+      std::vector<Interval> line;
+      for (int k = 0; k < n; k++) {
+        line.resize(d[k]+1);
+        for (int o = 0; o < stride[n]; o++) {
+          if ((o / stride[k]) % (d[k]+1) != 0)
+            continue;
+          for (int i = 0; i <= d[k]; i++) {
+            line[i] = Interval(0.0);
+            for (int q = 0; q <= i; q++)
+              line[i] += c[o + q*stride[k]] *
+                (Interval(binomial(i,q)) / binomial(d[k],q));
+          }
+          for (int i = 0; i <= d[k]; i++)
+            c[o + i*stride[k]] = line[i];
+        }
+      }
+    }
+
+    inline Expresion*
+    Polynomial::horner(Space* home, const Terms& u, const VarIndex& vi) {
+      // Pick the variable occurring in most monomials
+      std::map<int,int> occ;
+      for (Terms::const_iterator i = u.begin(); i != u.end(); ++i)
+        for (unsigned int k = 0; k < i->first.size(); k++)
+          if ((k == 0) || (i->first[k] != i->first[k-1]))
+            occ[i->first[k]]++;
+      if (occ.empty()) {
+        Terms::const_iterator i = u.find(Monomial());
+        return new ConstExpresion((i == u.end()) ? Interval(0.0) : i->second);
+      }
+      int v = occ.begin()->first;
+      for (std::map<int,int>::const_iterator o = occ.begin(); o != occ.end(); ++o)
+        if (o->second > occ[v])
+          v = o->first;
+
+      // Split into v * q + r
+      Terms q, r;
+      for (Terms::const_iterator i = u.begin(); i != u.end(); ++i) {
+        Monomial::const_iterator k =
+          std::find(i->first.begin(),i->first.end(),v);
+        if (k == i->first.end()) {
+          r.insert(*i);
+        } else {
+          Monomial m(i->first.begin(),k);
+          m.insert(m.end(),k+1,i->first.end());
+          q.insert(std::make_pair(m,i->second));
+        }
+      }
+
+      Expresion* e = new ExpresionView(vi[v]);
+      Terms::const_iterator one = q.find(Monomial());
+      if ((q.size() != 1) || (one == q.end()) ||
+          (lower(one->second) != 1.0) || (upper(one->second) != 1.0))
+        e = new Operation(home,*e,*horner(home,q,vi),'*',true);
+      if (!r.empty())
+        e = new Operation(home,*e,*horner(home,r,vi),'+',true);
+      return e;
+    }
+
+    forceinline Expresion*
+    Polynomial::horner(Space* home, const VarIndex& vi) const {
+      return horner(home,t,vi);
+    }
+
+    /*
+     * Expansion of expressions
+     *
+     */
+
+    forceinline bool
+    ExpresionView::polynomial(VarIndex& vi, Polynomial& p) const {
+      p.variable(vi.index(varimp));
+      return true;
+    }
+
+    forceinline int
+    ExpresionView::occurrences(void) const {
+      return 1;
+    }
+
+    forceinline bool
+    ConstExpresion::polynomial(VarIndex&, Polynomial& p) const {
+      p.constant(c);
+      return true;
+    }
+
+    forceinline bool
+    Operation::polynomial(VarIndex& vi, Polynomial& p) const {
+      Polynomial q;
+      if (!op1.polynomial(vi,p) || !op2.polynomial(vi,q))
+        return false;
+      switch(type) {
+      case '+': p.add(q,1.0); break;
+      case '-': p.add(q,-1.0); break;
+      case '*':
+        if (p.size() * q.size() > rewrite_terms)
+          return false;
+        p.mul(q); break;
+      default: return false;
+      }
+      return p.size() <= rewrite_terms;
+    }
+
+    forceinline int
+    Operation::occurrences(void) const {
+      return op1.occurrences() + op2.occurrences();
+    }
+
+    /*
+     * Rewriting of equations
+     *
+     */
+
+    forceinline bool
+    Equation::polynomial(VarIndex& vi, Polynomial& p) const {
+      Polynomial q;
+      if (!ex1->polynomial(vi,p) || !ex2->polynomial(vi,q))
+        return false;
+      p.add(q,-1.0);
+      return p.size() <= rewrite_terms;
+    }
+
+    forceinline Equation
+    Equation::rewrite(void) const {
+      VarIndex vi;
+      Polynomial p;
+      if (!polynomial(vi,p))
+        return *this;
+      Expresion* e = p.horner(home,vi);
+      if (e->occurrences() >= ex1->occurrences() + ex2->occurrences()) {
+        delete e;
+        return *this;
+      }
+      Equation r(home,*e,*new ConstExpresion(0.0));
+      r.fem = fem; r.use = new unsigned int(1);
+      return r;
+    }
+
+  }
+}